@@ -63,13 +63,17 @@ namespace sqlpp
 					return;
 				}
 
-				if (next_impl())
+				// Fields are bound once per result set: _bind_once calls the _bind_*_result
+				// methods below only for a new (or moved) row. Later steps just write the
+				// current values through the stored pointers.
+				result_row._bind_once(*this);
+
+				if (next_impl()) // writes values and null flags through the stored pointers
 				{
 					if (not result_row)
 					{
 						result_row.validate();
 					}
-					result_row._bind(*this); // bind result row values to results
 				}
 				else
 				{
@@ -79,13 +83,38 @@ namespace sqlpp
 			};
 			*/
 
-			// These are called by the result row to bind individual result values
+			// These are called by the result row to bind individual result values.
+			// Store the pointers, they stay valid until the row is bound again.
 			// More will be added over time
 			void _bind_boolean_result(size_t index, signed char* value, bool* is_null);
 			void _bind_floating_point_result(size_t index, double* value, bool* is_null);
 			void _bind_integral_result(size_t index, int64_t* value, bool* is_null);
 			void _bind_text_result(size_t index, const char** text, size_t* len);
 			...
+
+			// Optional: columnar fetch, see sqlpp11/columnar_result.h
+			template<typename Batch>
+			void next_batch(Batch& batch);
+
+			// something similar to this:
+			/*
+			{
+				if (_bound_batch != &batch) // the column arrays stay in place for the whole result
+				{
+					batch._bind(*this); // calls the _bind_*_column methods below
+					_bound_batch = &batch;
+				}
+				const size_t rows = fetch_rows_into_bound_columns(batch.capacity()); // set null bits for NULL values
+				batch._set_size(rows); // 0 signals the end of the result
+			};
+			*/
+
+			// These are called by the batch to bind its column arrays, each with room for capacity rows.
+			// The null bitmap has one bit per row (bit i % 8 of byte i / 8), set for NULL, cleared before each batch.
+			void _bind_boolean_column(size_t index, signed char* values, uint8_t* null_bitmap, size_t capacity);
+			void _bind_floating_point_column(size_t index, double* values, uint8_t* null_bitmap, size_t capacity);
+			void _bind_integral_column(size_t index, int64_t* values, uint8_t* null_bitmap, size_t capacity);
+			void _bind_text_column(size_t index, const char** values, size_t* lengths, uint8_t* null_bitmap, size_t capacity);
 		};
 
 	}
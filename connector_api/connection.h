@@ -30,6 +30,7 @@
 
 #include <string>
 #include <sqlpp11/connection.h>
+#include <sqlpp11/prepared_statement_cache.h>
 #include <sqlpp11/database/char_result.h> // You may use char result or bind result or both
 #include <sqlpp11/database/bind_result.h> // to represent results of select and prepared select
 
@@ -40,6 +41,13 @@ namespace sqlpp
 		// The context is not a requirement, but if the database requires
 		// any deviations from the SQL standard, you should use your own
 		// context in order to specialize the behaviour, see also interpreter.h
+		// Deriving from sqlpp::buffer_serializer_context_t gives you an append-only
+		// buffer with fast numeric formatting that can be reset() and reused per connection.
+		// Add `using _use_static_sql = std::true_type;` to have fully static statements
+		// written from sqlpp::static_sql_text_t<Statement>::_text instead of being serialized
+		// piece by piece. Do not do this if your serializers differ from the defaults.
+		// Deriving from sqlpp::parameterizing_serializer_context_t replaces literals by '?'
+		// and collects their values in _literals, which can be bound via _literals._bind().
 		struct context_t
 		{
 			template<typename T>
@@ -112,6 +120,14 @@ namespace sqlpp
 			template<typename PreparedRemove>
 			size_t run_prepared_remove(const PreparedRemove& r); // call r._bind_params()
 
+			//! prepared insert, update, remove or execute for many parameter sets in one call
+			//! rows is a contiguous range of PreparedStatement::_parameter_list_t, e.g. PreparedStatement::_batch_t
+			template<typename PreparedStatement, typename Rows>
+			size_t run_batch(const PreparedStatement& p, const Rows& rows);
+			// call p._bind_batch(rows.data(), rows.size()) and execute once,
+			// or call p._bind_params(row) and step for each row if the database has no array binding
+			// (prepared selects, including statements with returning(), do not compile here: their rows would be lost)
+
 			//! call run on the argument
 			template<typename T>
 				auto operator() (const T& t) -> decltype(t._run(*this))
@@ -126,6 +142,14 @@ namespace sqlpp
 					return t._prepare(*this);
 				}
 
+			//! prepare the argument or reuse a previously prepared statement of the same type and text
+			//! (requires a get_serializer_context() method for statements without static text)
+			template<typename T>
+				auto cached(const T& t) -> std::shared_ptr<decltype(this->prepare(t))>
+				{
+					return _statement_cache.get(*this, t);
+				}
+
 			//! start transaction
 			void start_transaction();
 
@@ -135,12 +159,28 @@ namespace sqlpp
 			//! rollback transaction with or without reporting the rollback (or throw if the transaction has been finished already)
 			void rollback_transaction(bool report);
 
+			//! optional: true while a transaction is open, however it was started
+			//! (connection_pool_t uses this to roll back on return, and issues a ROLLBACK in any case without it)
+			bool is_transaction_active() const;
+
+			//! create a savepoint with the given name within the current transaction
+			void savepoint(const std::string& name);
+
+			//! release the savepoint with the given name, keeping its changes in the transaction
+			void release_savepoint(const std::string& name);
+
+			//! rollback to the savepoint with the given name with or without reporting the rollback
+			void rollback_to_savepoint(const std::string& name, bool report);
+
 			//! report a rollback failure (will be called by transactions in case of a rollback failure in the destructor)
 			void report_rollback_failure(const std::string message) noexcept;
 
 			//! create a table, index or view
 			template <typename Create>
 			void create( const Create &c);
+
+		private:
+			sqlpp::prepared_statement_cache_t<connection> _statement_cache; // see sqlpp11/prepared_statement_cache.h
 		};
 
 	}
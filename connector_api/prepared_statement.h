@@ -54,6 +54,15 @@ namespace sqlpp
 			void _bind_floating_point_parameter(size_t index, const double* value, bool is_null);
 			void _bind_integral_parameter(size_t index, const int64_t* value, bool is_null);
 			void _bind_text_parameter(size_t index, const std::string* value, bool is_null);
+
+			// These are called by _bind_batch() of the prepared statements for db.run_batch(prepared, rows).
+			// They bind count rows at once: the value of row i is at reinterpret_cast<const char*>(value) + i * stride,
+			// and likewise for is_null. This matches row-wise array binding (e.g. ODBC's SQL_ATTR_PARAM_BIND_TYPE).
+			// Drivers without array binding can store the pointers and step through the rows in run_batch.
+			void _bind_boolean_parameter_array(size_t index, const signed char* value, const bool* is_null, size_t stride, size_t count);
+			void _bind_floating_point_parameter_array(size_t index, const double* value, const bool* is_null, size_t stride, size_t count);
+			void _bind_integral_parameter_array(size_t index, const int64_t* value, const bool* is_null, size_t stride, size_t count);
+			void _bind_text_parameter_array(size_t index, const std::string* value, const bool* is_null, size_t stride, size_t count);
 		};
 	}
 }
@@ -0,0 +1,404 @@
+/*
+ * async.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_ASYNC_H
+#define SQLPP_ASYNC_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/result.h>
+#include <sqlpp11/connection_pool.h>
+
+namespace sqlpp
+{
+	struct async_options_t
+	{
+		// Threads executing statements, each checking out a connection per statement
+		std::size_t workers = 4;
+		// Statements waiting for a worker, submitting more waits for room in the queue
+		std::size_t max_queue_depth = 256;
+		// Submitting throws when the queue stays full for this long
+		std::chrono::milliseconds enqueue_timeout = std::chrono::seconds(30);
+	};
+
+	// The rows of a select executed asynchronously.
+	// Results refer to their connection and prepared statement, so both are held until the rows are destroyed.
+	template<typename Db, typename DbResult, typename ResultRow>
+		class pooled_result_t
+		{
+			using _result_t = result_t<DbResult, ResultRow>;
+
+		public:
+			using iterator = typename _result_t::iterator;
+			using result_row_t = ResultRow;
+
+			pooled_result_t(pooled_connection_t<Db> db, std::shared_ptr<void> prepared, std::unique_ptr<_result_t> result):
+				_db(std::move(db)),
+				_prepared(std::move(prepared)),
+				_result(std::move(result))
+			{}
+
+			pooled_result_t(const pooled_result_t&) = delete;
+			pooled_result_t(pooled_result_t&&) = default;
+			pooled_result_t& operator=(const pooled_result_t&) = delete;
+			pooled_result_t& operator=(pooled_result_t&&) = default;
+			~pooled_result_t() = default;
+
+			iterator begin()
+			{
+				return _result->begin();
+			}
+
+			iterator end()
+			{
+				return _result->end();
+			}
+
+			const result_row_t& front() const
+			{
+				return _result->front();
+			}
+
+			bool empty() const
+			{
+				return _result->empty();
+			}
+
+			void pop_front()
+			{
+				_result->pop_front();
+			}
+
+		private:
+			// Destroyed in reverse order: rows first, connection last
+			pooled_connection_t<Db> _db;
+			std::shared_ptr<void> _prepared;
+			std::unique_ptr<_result_t> _result;
+		};
+
+	namespace detail
+	{
+		enum class async_state_t
+		{
+			queued,
+			running,
+			cancelled
+		};
+
+		template<typename Value>
+			struct async_task_t
+			{
+				// Whoever leaves the queued state owns the promise
+				bool _leave_queue(async_state_t state)
+				{
+					auto expected = async_state_t::queued;
+					return _state.compare_exchange_strong(expected, state);
+				}
+
+				std::atomic<async_state_t> _state{async_state_t::queued};
+				std::promise<Value> _promise;
+			};
+
+		// Turns what a connection returns into the value of an async_handle_t
+		template<typename Db, typename Value>
+			struct async_value_t
+			{
+				using type = Value;
+
+				template<typename Run>
+					static type _make(pooled_connection_t<Db> db, const Run& run)
+					{
+						std::shared_ptr<void> prepared;
+						return run(*db, prepared);
+					}
+			};
+
+		template<typename Db, typename DbResult, typename ResultRow>
+			struct async_value_t<Db, result_t<DbResult, ResultRow>>
+			{
+				using _result_t = result_t<DbResult, ResultRow>;
+				using type = pooled_result_t<Db, DbResult, ResultRow>;
+
+				template<typename Run>
+					static type _make(pooled_connection_t<Db> db, const Run& run)
+					{
+						std::shared_ptr<void> prepared;
+						std::unique_ptr<_result_t> result(new _result_t(run(*db, prepared)));
+						return type(std::move(db), std::move(prepared), std::move(result));
+					}
+			};
+	}
+
+	// The outcome of a statement executed by an async_executor_t
+	template<typename Value>
+		class async_handle_t
+		{
+		public:
+			async_handle_t(std::shared_ptr<detail::async_task_t<Value>> task):
+				_task(std::move(task)),
+				_future(_task->_promise.get_future())
+			{}
+
+			async_handle_t(const async_handle_t&) = delete;
+			async_handle_t(async_handle_t&&) = default;
+			async_handle_t& operator=(const async_handle_t&) = delete;
+			async_handle_t& operator=(async_handle_t&&) = default;
+			~async_handle_t() = default;
+
+			// Waits for the statement and returns its result, or throws what the statement threw
+			Value get()
+			{
+				return _future.get();
+			}
+
+			void wait() const
+			{
+				_future.wait();
+			}
+
+			template<typename Rep, typename Period>
+				std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout) const
+				{
+					return _future.wait_for(timeout);
+				}
+
+			bool valid() const
+			{
+				return _future.valid();
+			}
+
+			// Keeps a statement that is still queued from being executed, get() throws then.
+			// Returns false if the statement has been started already, it cannot be interrupted.
+			bool cancel()
+			{
+				if (not _task->_leave_queue(detail::async_state_t::cancelled))
+					return false;
+				_task->_promise.set_exception(std::make_exception_ptr(exception("async statement cancelled")));
+				return true;
+			}
+
+		private:
+			std::shared_ptr<detail::async_task_t<Value>> _task;
+			std::future<Value> _future;
+		};
+
+	// A statement to be prepared on each connection it runs on, see async_executor_t::prepare().
+	// The prepared statements are cached by the pooled connections and closed with them.
+	template<typename Db, typename Statement>
+		class async_prepared_t
+		{
+			using _pooled_t = detail::pooled_db_t<Db>;
+
+		public:
+			using _prepared_t = decltype(std::declval<_pooled_t&>().prepare(std::declval<const Statement&>()));
+
+			async_prepared_t(const Statement& statement):
+				_statement(statement)
+			{}
+
+			typename _prepared_t::_parameter_list_t params;
+
+			// Called by the worker using db only
+			std::shared_ptr<_prepared_t> _get(_pooled_t& db) const
+			{
+				return db._statements.get(db, _statement);
+			}
+
+		private:
+			Statement _statement;
+		};
+
+	// Executes statements on worker threads with connections of a pool, e.g.
+	//   async_executor_t<sqlite3::connection> async(pool);
+	//   auto inserted = async.db_async(insert_into(t).set(t.beta = "cheese"));
+	//   auto rows = async.db_async(select(t.alpha).from(t).where(true));
+	//   ...
+	//   for (const auto& row : rows.get())
+	//     ...
+	//
+	//   auto prepared = async.prepare(select(t.alpha).from(t).where(t.beta == parameter(t.beta)));
+	//   prepared.params.beta = "cheese";
+	//   auto cheese = async.run_async(prepared);
+	//
+	// Handles return what the connection would, except for selects: their rows keep the connection
+	// checked out until they are destroyed. Statements are started in the order they are submitted.
+	// When max_queue_depth statements are waiting, submitting blocks, and throws after enqueue_timeout.
+	// Cancelled statements are dropped when a worker gets to them.
+	// The destructor waits for the queued statements to finish.
+	template<typename Db>
+		class async_executor_t
+		{
+			using _pooled_t = detail::pooled_db_t<Db>;
+
+			template<typename Statement>
+				using _value_t = detail::async_value_t<Db, decltype(std::declval<_pooled_t&>()(std::declval<const Statement&>()))>;
+
+		public:
+			async_executor_t(connection_pool_t<Db>& pool, const async_options_t& options = {}):
+				_pool(pool),
+				_options(options)
+			{
+				if (options.workers == 0)
+					throw exception("async_executor_t requires at least one worker");
+				if (options.max_queue_depth == 0)
+					throw exception("async_executor_t requires a max_queue_depth greater than zero");
+				for (std::size_t i = 0; i < options.workers; ++i)
+					_workers.emplace_back(&async_executor_t::_work, this);
+			}
+
+			async_executor_t(const async_executor_t&) = delete;
+			async_executor_t(async_executor_t&&) = delete;
+			async_executor_t& operator=(const async_executor_t&) = delete;
+			async_executor_t& operator=(async_executor_t&&) = delete;
+
+			~async_executor_t()
+			{
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_stopping = true;
+				}
+				_queued.notify_all();
+				for (auto& worker : _workers)
+					worker.join();
+			}
+
+			template<typename Statement>
+				auto db_async(const Statement& statement)
+				-> async_handle_t<typename _value_t<Statement>::type>
+				{
+					using _result_t = decltype(std::declval<_pooled_t&>()(statement));
+					return _submit<_value_t<Statement>>([statement](_pooled_t& db, std::shared_ptr<void>&) -> _result_t
+							{
+								return db(statement);
+							});
+				}
+
+			template<typename Statement>
+				async_prepared_t<Db, Statement> prepare(const Statement& statement)
+				{
+					return {statement};
+				}
+
+			// Runs with a copy of the current parameters
+			template<typename Statement>
+				auto run_async(const async_prepared_t<Db, Statement>& prepared)
+				-> async_handle_t<typename _value_t<typename async_prepared_t<Db, Statement>::_prepared_t>::type>
+				{
+					using _prepared_t = typename async_prepared_t<Db, Statement>::_prepared_t;
+					using _result_t = decltype(std::declval<_pooled_t&>()(std::declval<const _prepared_t&>()));
+					return _submit<_value_t<_prepared_t>>([prepared](_pooled_t& db, std::shared_ptr<void>& keep) -> _result_t
+							{
+								const auto statement = prepared._get(db);
+								statement->params = prepared.params;
+								keep = statement;
+								return db(*statement);
+							});
+				}
+
+			// Statements waiting for a worker, including cancelled ones
+			std::size_t queued() const
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				return _jobs.size();
+			}
+
+		private:
+			template<typename Value, typename Run>
+				async_handle_t<typename Value::type> _submit(Run run)
+				{
+					auto task = std::make_shared<detail::async_task_t<typename Value::type>>();
+					async_handle_t<typename Value::type> handle(task);
+					_push([this, task, run]()
+							{
+								if (not task->_leave_queue(detail::async_state_t::running))
+									return;
+								try
+								{
+									task->_promise.set_value(Value::_make(_pool.checkout(), run));
+								}
+								catch (...)
+								{
+									task->_promise.set_exception(std::current_exception());
+								}
+							});
+					return handle;
+				}
+
+			void _push(std::function<void()> job)
+			{
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					if (not _not_full.wait_for(lock, _options.enqueue_timeout, [this] { return _jobs.size() < _options.max_queue_depth; }))
+						throw exception("async_executor_t: queue still full after the enqueue timeout");
+					_jobs.push_back(std::move(job));
+				}
+				_queued.notify_one();
+			}
+
+			void _work()
+			{
+				while (true)
+				{
+					std::function<void()> job;
+					{
+						std::unique_lock<std::mutex> lock(_mutex);
+						_queued.wait(lock, [this] { return _stopping or not _jobs.empty(); });
+						if (_jobs.empty())
+							return;
+						job = std::move(_jobs.front());
+						_jobs.pop_front();
+					}
+					_not_full.notify_one();
+					job();
+				}
+			}
+
+			connection_pool_t<Db>& _pool;
+			const async_options_t _options;
+			mutable std::mutex _mutex;
+			std::condition_variable _queued;
+			std::condition_variable _not_full;
+			std::deque<std::function<void()>> _jobs;
+			bool _stopping = false;
+			std::vector<std::thread> _workers;
+		};
+}
+
+#endif
@@ -116,6 +116,12 @@ namespace sqlpp
 					target._bind_boolean_parameter(index, &_value, _is_null);
 				}
 
+			template<typename Target>
+				void _bind_array(Target& target, size_t index, size_t stride, size_t count) const
+				{
+					target._bind_boolean_parameter_array(index, &_value, &_is_null, stride, count);
+				}
+
 		private:
 			signed char _value;
 			bool _is_null;
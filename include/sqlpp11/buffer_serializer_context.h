@@ -0,0 +1,237 @@
+/*
+ * buffer_serializer_context.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_BUFFER_SERIALIZER_CONTEXT_H
+#define SQLPP_BUFFER_SERIALIZER_CONTEXT_H
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <type_traits>
+
+namespace sqlpp
+{
+	// Append-only serializer context that writes straight into a std::string.
+	//
+	// In contrast to serializer_context_t, no std::ostream is involved: there are
+	// no locale lookups and no virtual streambuf calls, and integral and floating
+	// point values are formatted by hand. Call reset() between statements to reuse
+	// the buffer; its capacity is kept, so a warmed up context does not allocate.
+	struct buffer_serializer_context_t
+	{
+		// Returned by escape(), appended with single quotes doubled.
+		// Refers to the escaped characters, so it must not outlive them.
+		struct escaped_t
+		{
+			const char* _data;
+			std::size_t _len;
+
+			operator std::string() const
+			{
+				std::string result;
+				result.reserve(_len);
+				for (std::size_t i = 0; i < _len; ++i)
+				{
+					if (_data[i] == '\'')
+						result.push_back('\'');
+					result.push_back(_data[i]);
+				}
+				return result;
+			}
+		};
+
+		buffer_serializer_context_t() = default;
+
+		explicit buffer_serializer_context_t(std::size_t capacity)
+		{
+			_buffer.reserve(capacity);
+		}
+
+		buffer_serializer_context_t(const buffer_serializer_context_t&) = default;
+		buffer_serializer_context_t(buffer_serializer_context_t&&) = default;
+		buffer_serializer_context_t& operator=(const buffer_serializer_context_t&) = default;
+		buffer_serializer_context_t& operator=(buffer_serializer_context_t&&) = default;
+		~buffer_serializer_context_t() = default;
+
+		const std::string& str() const
+		{
+			return _buffer;
+		}
+
+		const char* data() const
+		{
+			return _buffer.data();
+		}
+
+		std::size_t size() const
+		{
+			return _buffer.size();
+		}
+
+		void reset()
+		{
+			_buffer.clear();
+		}
+
+		void reserve(std::size_t capacity)
+		{
+			_buffer.reserve(capacity);
+		}
+
+		escaped_t escape(const std::string& arg) const
+		{
+			return {arg.data(), arg.size()};
+		}
+
+		escaped_t escape(const char* data, std::size_t len) const
+		{
+			return {data, len};
+		}
+
+		buffer_serializer_context_t& append(const char* data, std::size_t len)
+		{
+			_buffer.append(data, len);
+			return *this;
+		}
+
+		buffer_serializer_context_t& operator<<(char c)
+		{
+			_buffer.push_back(c);
+			return *this;
+		}
+
+		buffer_serializer_context_t& operator<<(const char* s)
+		{
+			_buffer.append(s);
+			return *this;
+		}
+
+		buffer_serializer_context_t& operator<<(const std::string& s)
+		{
+			_buffer.append(s);
+			return *this;
+		}
+
+		buffer_serializer_context_t& operator<<(const escaped_t& e)
+		{
+			const char* begin = e._data;
+			const char* const end = e._data + e._len;
+			while (const char* quote = static_cast<const char*>(std::memchr(begin, '\'', static_cast<std::size_t>(end - begin))))
+			{
+				_buffer.append(begin, static_cast<std::size_t>(quote + 1 - begin));
+				_buffer.push_back('\'');
+				begin = quote + 1;
+			}
+			_buffer.append(begin, static_cast<std::size_t>(end - begin));
+			return *this;
+		}
+
+		// Same as std::ostream without boolalpha
+		buffer_serializer_context_t& operator<<(bool b)
+		{
+			_buffer.push_back(b ? '1' : '0');
+			return *this;
+		}
+
+		template<typename T>
+			auto operator<<(T t)
+			-> typename std::enable_if<std::is_integral<T>::value and std::is_signed<T>::value
+			and not std::is_same<T, char>::value and not std::is_same<T, bool>::value, buffer_serializer_context_t&>::type
+			{
+				const auto value = static_cast<std::int64_t>(t);
+				if (value < 0)
+				{
+					_buffer.push_back('-');
+					// negate in unsigned arithmetic to handle the minimum value
+					return _append_unsigned(std::uint64_t(0) - static_cast<std::uint64_t>(value));
+				}
+				return _append_unsigned(static_cast<std::uint64_t>(value));
+			}
+
+		template<typename T>
+			auto operator<<(T t)
+			-> typename std::enable_if<std::is_integral<T>::value and std::is_unsigned<T>::value
+			and not std::is_same<T, char>::value and not std::is_same<T, bool>::value, buffer_serializer_context_t&>::type
+			{
+				return _append_unsigned(static_cast<std::uint64_t>(t));
+			}
+
+		// Integral values are written as integers, everything else with the
+		// shortest of 15 or 17 significant digits that survives a round trip.
+		buffer_serializer_context_t& operator<<(double d)
+		{
+			if (std::isfinite(d) and std::fabs(d) < 9007199254740992.0 and d == std::trunc(d))
+			{
+				if (d == 0.0) // also covers -0.0
+					return operator<<('0');
+				return operator<<(static_cast<std::int64_t>(d));
+			}
+
+			char buffer[32];
+			int len = std::snprintf(buffer, sizeof(buffer), "%.15g", d);
+			if (std::isfinite(d) and std::strtod(buffer, nullptr) != d)
+				len = std::snprintf(buffer, sizeof(buffer), "%.17g", d);
+			// snprintf honours LC_NUMERIC, SQL always wants a decimal point
+			for (int i = 0; i < len; ++i)
+			{
+				if (buffer[i] == ',')
+					buffer[i] = '.';
+			}
+			_buffer.append(buffer, static_cast<std::size_t>(len));
+			return *this;
+		}
+
+		buffer_serializer_context_t& operator<<(float f)
+		{
+			return operator<<(static_cast<double>(f));
+		}
+
+	private:
+		buffer_serializer_context_t& _append_unsigned(std::uint64_t value)
+		{
+			char buffer[20];
+			char* const end = buffer + sizeof(buffer);
+			char* begin = end;
+			do
+			{
+				*--begin = static_cast<char>('0' + value % 10);
+				value /= 10;
+			}
+			while (value);
+			_buffer.append(begin, static_cast<std::size_t>(end - begin));
+			return *this;
+		}
+
+		std::string _buffer;
+	};
+}
+
+#endif
@@ -0,0 +1,337 @@
+/*
+ * bulk_update.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_BULK_UPDATE_H
+#define SQLPP_BULK_UPDATE_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <sqlpp11/type_traits.h>
+#include <sqlpp11/logic.h>
+#include <sqlpp11/parameter.h>
+#include <sqlpp11/serializer.h>
+#include <sqlpp11/create_table.h>
+#include <sqlpp11/prepared_update.h>
+#include <sqlpp11/transaction.h>
+#include <sqlpp11/detail/index_sequence.h>
+#include <sqlpp11/detail/type_set.h>
+#include <sqlpp11/detail/value_binder.h>
+
+namespace sqlpp
+{
+	// Whether bulk updates are serialized as a join with a VALUES list, e.g.
+	//   UPDATE t SET a=bulk_values.a FROM (VALUES (?,?),(?,?)) AS bulk_values (id,a) WHERE t.id=bulk_values.id
+	// instead of one CASE expression per column, e.g.
+	//   UPDATE t SET a=CASE id WHEN ? THEN ? WHEN ? THEN ? ELSE a END WHERE id IN (?,?)
+	// Connectors for dialects that support the former (e.g. PostgreSQL) specialize this for their context.
+	template<typename Context>
+		struct bulk_update_uses_from_values_t: std::false_type
+		{};
+
+	// The text of a bulk update with a fixed number of records, see bulk_update_t
+	template<typename Key, typename... Columns>
+		struct bulk_update_statement_t
+		{
+			using _traits = make_traits<no_value_t, tag::is_statement>;
+			using _nodes = detail::type_vector<>;
+
+			using _run_check = consistent_t;
+			using _prepare_check = consistent_t;
+
+			template<typename Db>
+				auto _prepare(Db& db) const
+				-> prepared_update_t<Db, bulk_update_statement_t>
+				{
+					return {{}, {}, db.prepare_update(*this)};
+				}
+
+			// Parameter index of the key and of the value of column C in record R
+			template<typename Context>
+				static std::size_t _key_index(std::size_t records, std::size_t column, std::size_t record)
+				{
+					return bulk_update_uses_from_values_t<Context>::value
+						? record * (1 + sizeof...(Columns))
+						: (column * records + record) * 2;
+				}
+
+			template<typename Context>
+				static std::size_t _value_index(std::size_t records, std::size_t column, std::size_t record)
+				{
+					return bulk_update_uses_from_values_t<Context>::value
+						? record * (1 + sizeof...(Columns)) + 1 + column
+						: (column * records + record) * 2 + 1;
+				}
+
+			// The key is repeated in the WHERE clause of the CASE form
+			template<typename Context>
+				static std::size_t _where_key_index(std::size_t records, std::size_t record)
+				{
+					return 2 * sizeof...(Columns) * records + record;
+				}
+
+			template<typename Context>
+				static constexpr std::size_t _parameters_per_record()
+				{
+					return bulk_update_uses_from_values_t<Context>::value ? 1 + sizeof...(Columns) : 1 + 2 * sizeof...(Columns);
+				}
+
+			std::size_t _records;
+		};
+
+	template<typename Context, typename Key, typename... Columns>
+		struct serializer_t<Context, bulk_update_statement_t<Key, Columns...>>
+		{
+			using _serialize_check = consistent_t;
+			using T = bulk_update_statement_t<Key, Columns...>;
+			using _table_t = typename Key::_table;
+
+			// Placeholders are serialized like parameters, so that contexts can number them
+			template<typename Column>
+				static void _placeholder(Context& context)
+				{
+					serialize(parameter_t<value_type_of<Column>, Column>{}, context);
+				}
+
+			static Context& _(const T& t, Context& context)
+			{
+				const char* const names[] = {name_of<Columns>::char_ptr()...};
+				void (* const placeholders[])(Context&) = {&_placeholder<Columns>...};
+				const char* const key = name_of<Key>::char_ptr();
+				const char* const table = name_of<_table_t>::char_ptr();
+
+				context << "UPDATE " << table << " SET ";
+				if (bulk_update_uses_from_values_t<Context>::value)
+				{
+					for (std::size_t c = 0; c < sizeof...(Columns); ++c)
+						context << (c ? "," : "") << names[c] << "=bulk_values." << names[c];
+					context << " FROM (VALUES ";
+					for (std::size_t r = 0; r < t._records; ++r)
+					{
+						context << (r ? ",(" : "(");
+						_placeholder<Key>(context);
+						for (std::size_t c = 0; c < sizeof...(Columns); ++c)
+						{
+							context << ',';
+							placeholders[c](context);
+						}
+						context << ')';
+					}
+					context << ") AS bulk_values (" << key;
+					for (std::size_t c = 0; c < sizeof...(Columns); ++c)
+						context << ',' << names[c];
+					context << ") WHERE " << table << '.' << key << "=bulk_values." << key;
+				}
+				else
+				{
+					for (std::size_t c = 0; c < sizeof...(Columns); ++c)
+					{
+						context << (c ? "," : "") << names[c] << "=CASE " << key;
+						for (std::size_t r = 0; r < t._records; ++r)
+						{
+							context << " WHEN ";
+							_placeholder<Key>(context);
+							context << " THEN ";
+							placeholders[c](context);
+						}
+						context << " ELSE " << names[c] << " END";
+					}
+					context << " WHERE " << key << " IN (";
+					for (std::size_t r = 0; r < t._records; ++r)
+					{
+						if (r)
+							context << ',';
+						_placeholder<Key>(context);
+					}
+					context << ')';
+				}
+				return context;
+			}
+		};
+
+	// Updates the given columns of many rows, identified by the table's primary key, with one
+	// statement per chunk of records instead of one statement per row:
+	//   bulk_update(db, t.a, t.b).run(records);
+	// Records are tuples of key, a and b, e.g. std::vector<std::tuple<int64_t, std::string, bool>>.
+	//
+	// Like chunked_insert_t, records are split greedily into chunks of 256, 64, 8 and 1 records,
+	// skipping chunk sizes that would need more than max_parameters placeholders. Each chunk size is
+	// prepared once, on first use. All chunks of a run() are executed in one transaction, unless
+	// run() is given a transaction or savepoint of the caller, e.g. run(tx, records).
+	template<typename Db, typename... Columns>
+		class bulk_update_t
+		{
+			using _table_t = typename std::tuple_element<0, std::tuple<Columns...>>::type::_table;
+			static_assert(get_primary_key_columns<_table_t>::type::size::value == 1, "bulk_update() requires a table with a single primary key column");
+			static_assert(logic::all_t<std::is_same<typename Columns::_table, _table_t>::value...>::value, "bulk_update() columns have to be of the same table");
+			static_assert(not detail::has_duplicates<Columns...>::value, "at least one duplicate column in bulk_update()");
+			static_assert(logic::none_t<must_not_update_t<Columns>::value...>::value, "at least one column of bulk_update() is prohibited from being updated by its definition");
+
+		public:
+			using _key_t = typename get_single_primary_key_column<_table_t>::type;
+
+		private:
+			static_assert(not detail::is_element_of<_key_t, detail::make_type_set_t<Columns...>>::value, "bulk_update() must not update the primary key");
+
+			using _statement_t = bulk_update_statement_t<_key_t, Columns...>;
+			using _prepared_t = decltype(std::declval<Db&>().prepare(std::declval<const _statement_t&>()));
+			using _context_t = typename Db::_serializer_context_t;
+
+			template<std::size_t I>
+				using _value_type_t = value_type_of<typename std::tuple_element<I, std::tuple<_key_t, Columns...>>::type>;
+
+		public:
+			bulk_update_t(Db& db, std::size_t max_parameters = 999):
+				_db(db)
+			{
+				for (const std::size_t size : {256, 64, 8})
+				{
+					if (size * _statement_t::template _parameters_per_record<_context_t>() <= max_parameters)
+						_chunk_sizes.push_back(size);
+				}
+				_chunk_sizes.push_back(1);
+				_prepared.resize(_chunk_sizes.size());
+			}
+
+			bulk_update_t(const bulk_update_t&) = delete;
+			bulk_update_t(bulk_update_t&&) = default;
+			bulk_update_t& operator=(const bulk_update_t&) = delete;
+			bulk_update_t& operator=(bulk_update_t&&) = delete;
+			~bulk_update_t() = default;
+
+			// Chunk sizes in descending order
+			const std::vector<std::size_t>& chunk_sizes() const
+			{
+				return _chunk_sizes;
+			}
+
+			// Updates one row per record in one transaction and returns the number of affected rows
+			template<typename Range>
+				std::size_t run(const Range& records)
+				{
+					auto transaction = start_transaction(_db);
+					const auto affected = _update(records);
+					transaction.commit();
+					return affected;
+				}
+
+			// Updates within a transaction or savepoint of the caller, which is left open.
+			// The records are updated under a savepoint of their own, which is rolled back if one fails.
+			template<typename Range>
+				std::size_t run(transaction_t<Db>& transaction, const Range& records)
+				{
+					auto savepoint = transaction.savepoint();
+					const auto affected = _update(records);
+					savepoint.release();
+					return affected;
+				}
+
+			template<typename Range>
+				std::size_t run(savepoint_t<Db>& enclosing, const Range& records)
+				{
+					auto savepoint = enclosing.savepoint();
+					const auto affected = _update(records);
+					savepoint.release();
+					return affected;
+				}
+
+		private:
+			template<typename Range>
+				std::size_t _update(const Range& records)
+				{
+					using _record_t = typename std::decay<decltype(*std::begin(records))>::type;
+					static_assert(std::tuple_size<_record_t>::value == 1 + sizeof...(Columns), "bulk_update() records require a key and one value per column");
+					_check_record<_record_t>(detail::make_index_sequence<1 + sizeof...(Columns)>{});
+					// Record elements are bound in place and read when a chunk is executed, after the iterator has moved on
+					static_assert(std::is_lvalue_reference<decltype(*std::begin(records))>::value, "bulk_update() requires a range that yields references to its records, not copies");
+
+					const auto count = static_cast<std::size_t>(std::distance(std::begin(records), std::end(records)));
+					auto it = std::begin(records);
+					std::size_t affected = 0;
+					std::size_t begin = 0;
+					std::size_t chunk = 0;
+					while (begin < count)
+					{
+						while (_chunk_sizes[chunk] > count - begin)
+							++chunk;
+						const auto size = _chunk_sizes[chunk];
+						auto& prepared = _get_prepared(chunk);
+						_binder.resize(size * _statement_t::template _parameters_per_record<_context_t>());
+						for (std::size_t record = 0; record < size; ++record, ++it)
+							_bind_record(prepared._prepared_statement, size, record, *it, detail::make_index_sequence<sizeof...(Columns)>{});
+						affected += _db(prepared);
+						begin += size;
+					}
+					return affected;
+				}
+
+			template<typename Record, std::size_t... Is>
+				static void _check_record(const detail::index_sequence<Is...>&)
+				{
+					static_assert(logic::all_t<detail::is_range_member_compatible<_value_type_t<Is>,
+							typename std::tuple_element<Is, Record>::type>::value...>::value,
+							"bulk_update() record element types do not match the key and column types");
+				}
+
+			_prepared_t& _get_prepared(std::size_t chunk)
+			{
+				if (not _prepared[chunk])
+					_prepared[chunk].reset(new _prepared_t(_db.prepare(_statement_t{_chunk_sizes[chunk]})));
+				return *_prepared[chunk];
+			}
+
+			template<typename Target, typename Record, std::size_t... Is>
+				void _bind_record(Target& target, std::size_t records, std::size_t record, const Record& values, const detail::index_sequence<Is...>&)
+				{
+					using swallow = int[];  // see interpret_tuple.h
+					(void) swallow{0,
+						(_binder.bind(target, _statement_t::template _key_index<_context_t>(records, Is, record), std::get<0>(values), _value_type_t<0>{}),
+						 _binder.bind(target, _statement_t::template _value_index<_context_t>(records, Is, record), std::get<Is + 1>(values), _value_type_t<Is + 1>{}), 0)...};
+					if (not bulk_update_uses_from_values_t<_context_t>::value)
+						_binder.bind(target, _statement_t::template _where_key_index<_context_t>(records, record), std::get<0>(values), _value_type_t<0>{});
+				}
+
+			Db& _db;
+			std::vector<std::size_t> _chunk_sizes;
+			std::vector<std::unique_ptr<_prepared_t>> _prepared;
+			detail::value_binder_t _binder;
+		};
+
+	template<typename Db, typename... Columns>
+		bulk_update_t<Db, Columns...> bulk_update(Db& db, Columns...)
+		{
+			static_assert(sizeof...(Columns), "at least one column required in bulk_update()");
+			static_assert(logic::all_t<is_column_t<Columns>::value...>::value, "at least one argument is not a column in bulk_update()");
+			return {db};
+		}
+}
+
+#endif
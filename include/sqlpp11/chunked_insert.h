@@ -0,0 +1,337 @@
+/*
+ * chunked_insert.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_CHUNKED_INSERT_H
+#define SQLPP_CHUNKED_INSERT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sqlpp11/boolean.h>
+#include <sqlpp11/floating_point.h>
+#include <sqlpp11/insert_value.h>
+#include <sqlpp11/integral.h>
+#include <sqlpp11/logic.h>
+#include <sqlpp11/text.h>
+#include <sqlpp11/transaction.h>
+#include <sqlpp11/wrap_operand.h>
+#include <sqlpp11/detail/index_sequence.h>
+#include <sqlpp11/detail/value_binder.h>
+
+namespace sqlpp
+{
+	// Runs the rows of a multi-row insert, i.e. insert_into(t).columns(...) with values.add(...),
+	// as a sequence of prepared multi-row inserts with a fixed number of rows each.
+	//
+	// Instead of one statement with all rows, which may exceed the number of bind variables or the
+	// SQL length a backend accepts (and is slow to parse), rows are split greedily into chunks of
+	// 256, 64, 8 and 1 rows. Chunk sizes that would need more than max_parameters placeholders are
+	// skipped. Each chunk size is prepared once, on first use, and reused for subsequent runs.
+	//
+	// DEFAULT cannot be bound, so rows containing a default value are inserted one by one.
+	//
+	// from_range() inserts a range of user structs instead, binding the given data members directly:
+	//   chunked_insert(db, insert_into(t).columns(t.a, t.b)).from_range(rows, &Row::a, &Row::b);
+	//
+	// Both start a transaction of their own unless they are given one of the caller's, or a savepoint:
+	//   auto tx = start_transaction(db);
+	//   inserter.run(tx, rows);
+	//   tx.commit();
+	template<typename Db, typename Insert>
+		class chunked_insert_t
+		{
+			using _data_t = typename std::decay<decltype(std::declval<const Insert&>().values._data)>::type;
+			using _prepared_t = decltype(std::declval<Db&>().prepare(std::declval<const Insert&>()));
+			using _target_t = typename _prepared_t::_prepared_statement_t;
+
+			static_assert(detail::type_vector_size<parameters_of<Insert>>::value == 0, "chunked_insert() binds row values only, parameters (e.g. in on_conflict().do_update()) are not supported");
+
+		public:
+			using _value_tuple_t = typename _data_t::_value_tuple_t;
+			static constexpr std::size_t _no_of_columns = std::tuple_size<_value_tuple_t>::value;
+
+		private:
+			template<std::size_t I>
+				using _column_value_type_t = value_type_of<typename std::tuple_element<I, _value_tuple_t>::type::_column_t>;
+
+		public:
+
+			chunked_insert_t(Db& db, const Insert& insert, std::size_t max_parameters = 999):
+				_db(db),
+				_statement(insert)
+			{
+				_statement.values._data._insert_values.clear();
+				for (const std::size_t size : {256, 64, 8})
+				{
+					if (size * _no_of_columns <= max_parameters)
+						_chunk_sizes.push_back(size);
+				}
+				_chunk_sizes.push_back(1);
+				_prepared.resize(_chunk_sizes.size());
+			}
+
+			chunked_insert_t(const chunked_insert_t&) = delete;
+			chunked_insert_t(chunked_insert_t&&) = default;
+			chunked_insert_t& operator=(const chunked_insert_t&) = delete;
+			chunked_insert_t& operator=(chunked_insert_t&&) = delete;
+			~chunked_insert_t() = default;
+
+			// Chunk sizes in descending order
+			const std::vector<std::size_t>& chunk_sizes() const
+			{
+				return _chunk_sizes;
+			}
+
+			// Inserts the rows added to insert.values in one transaction and returns their number
+			std::size_t run(const Insert& insert)
+			{
+				return run(insert.values._data._insert_values);
+			}
+
+			std::size_t run(const std::vector<_value_tuple_t>& rows)
+			{
+				auto transaction = start_transaction(_db);
+				_insert(rows);
+				transaction.commit();
+				return rows.size();
+			}
+
+			// Inserts the rows within a transaction or savepoint of the caller, which is left open.
+			// The rows are inserted under a savepoint of their own, which is rolled back if one fails.
+			std::size_t run(transaction_t<Db>& transaction, const Insert& insert)
+			{
+				return run(transaction, insert.values._data._insert_values);
+			}
+
+			std::size_t run(transaction_t<Db>& transaction, const std::vector<_value_tuple_t>& rows)
+			{
+				auto savepoint = transaction.savepoint();
+				_insert(rows);
+				savepoint.release();
+				return rows.size();
+			}
+
+			std::size_t run(savepoint_t<Db>& enclosing, const Insert& insert)
+			{
+				return run(enclosing, insert.values._data._insert_values);
+			}
+
+			std::size_t run(savepoint_t<Db>& enclosing, const std::vector<_value_tuple_t>& rows)
+			{
+				auto savepoint = enclosing.savepoint();
+				_insert(rows);
+				savepoint.release();
+				return rows.size();
+			}
+
+			// Inserts the rows of a range of structs in one transaction and returns their number.
+			// Takes one data member pointer per column, e.g. &Row::a. Nothing is copied except for
+			// members that need a conversion to the bound type, e.g. int to int64_t.
+			template<typename Range, typename... Members>
+				std::size_t from_range(const Range& rows, Members... members)
+				{
+					auto transaction = start_transaction(_db);
+					const auto count = _insert_range(rows, members...);
+					transaction.commit();
+					return count;
+				}
+
+			// Like run(), these insert within a transaction or savepoint of the caller
+			template<typename Range, typename... Members>
+				std::size_t from_range(transaction_t<Db>& transaction, const Range& rows, Members... members)
+				{
+					auto savepoint = transaction.savepoint();
+					const auto count = _insert_range(rows, members...);
+					savepoint.release();
+					return count;
+				}
+
+			template<typename Range, typename... Members>
+				std::size_t from_range(savepoint_t<Db>& enclosing, const Range& rows, Members... members)
+				{
+					auto savepoint = enclosing.savepoint();
+					const auto count = _insert_range(rows, members...);
+					savepoint.release();
+					return count;
+				}
+
+		private:
+			void _insert(const std::vector<_value_tuple_t>& rows)
+			{
+				std::size_t begin = 0;
+				while (begin < rows.size())
+				{
+					auto end = begin;
+					while (end < rows.size() and not _has_default(rows[end], detail::make_index_sequence<_no_of_columns>{}))
+						++end;
+					_run_chunks(begin, end, [this, &rows](_target_t& target, std::size_t offset, std::size_t index)
+							{
+								_bind_row(target, offset, rows[index], detail::make_index_sequence<_no_of_columns>{});
+							});
+					if (end < rows.size())
+					{
+						auto single = _statement;
+						single.values._data._insert_values.push_back(rows[end]);
+						_db(single);
+						++end;
+					}
+					begin = end;
+				}
+			}
+
+			template<typename Range, typename... Members>
+				std::size_t _insert_range(const Range& rows, Members... members)
+				{
+					static_assert(sizeof...(Members) == _no_of_columns, "from_range() requires one member per column");
+					static_assert(logic::all_t<std::is_member_object_pointer<Members>::value...>::value, "from_range() arguments have to be data member pointers");
+					_check_members(detail::make_index_sequence<_no_of_columns>{}, members...);
+					// Members are bound in place and read when a chunk is executed, after the iterator has moved on
+					static_assert(std::is_lvalue_reference<decltype(*std::begin(rows))>::value, "from_range() requires a range that yields references to its rows, not copies");
+
+					const auto count = static_cast<std::size_t>(std::distance(std::begin(rows), std::end(rows)));
+					auto it = std::begin(rows);
+					_run_chunks(0, count, [this, &it, &members...](_target_t& target, std::size_t offset, std::size_t)
+							{
+								_bind_members(target, offset, *it, detail::make_index_sequence<_no_of_columns>{}, members...);
+								++it;
+							});
+					return count;
+				}
+
+			template<typename BindRow>
+			void _run_chunks(std::size_t begin, std::size_t end, const BindRow& bind_row)
+			{
+				std::size_t chunk = 0;
+				while (begin < end)
+				{
+					while (_chunk_sizes[chunk] > end - begin)
+						++chunk;
+					const auto size = _chunk_sizes[chunk];
+					auto& prepared = _get_prepared(chunk);
+					_binder.resize(size * _no_of_columns);
+					for (std::size_t row = 0; row < size; ++row)
+						bind_row(prepared._prepared_statement, row * _no_of_columns, begin + row);
+					_db(prepared);
+					begin += size;
+				}
+			}
+
+			_prepared_t& _get_prepared(std::size_t chunk)
+			{
+				if (not _prepared[chunk])
+				{
+					auto statement = _statement;
+					statement.values._data._placeholder_rows = _chunk_sizes[chunk];
+					_prepared[chunk].reset(new _prepared_t(_db.prepare(statement)));
+				}
+				return *_prepared[chunk];
+			}
+
+			template<std::size_t... Is>
+				static bool _has_default(const _value_tuple_t& row, const detail::index_sequence<Is...>&)
+				{
+					bool result = false;
+					using swallow = int[];  // see interpret_tuple.h
+					(void) swallow{0, (result = result or std::get<Is>(row)._is_default, 0)...};
+					return result;
+				}
+
+			template<typename Target, std::size_t... Is>
+				void _bind_row(Target& target, std::size_t offset, const _value_tuple_t& row, const detail::index_sequence<Is...>&)
+				{
+					using swallow = int[];  // see interpret_tuple.h
+					(void) swallow{0, (_bind_value(target, offset + Is, std::get<Is>(row)), 0)...};
+				}
+
+			template<typename Target, typename Column>
+				void _bind_value(Target& target, std::size_t index, const insert_value_t<Column>& value)
+				{
+					const bool is_null = value._is_null or (insert_value_t<Column>::_trivial_value_is_null and value._value._is_trivial());
+					_bind_operand(target, index, value._value, is_null);
+				}
+
+			template<typename Target>
+				void _bind_operand(Target& target, std::size_t index, const boolean_operand& operand, bool is_null)
+				{
+					_binder.bind(target, index, operand._t, boolean{}, is_null);
+				}
+
+			template<typename Target>
+				void _bind_operand(Target& target, std::size_t index, const integral_operand& operand, bool is_null)
+				{
+					target._bind_integral_parameter(index, &operand._t, is_null);
+				}
+
+			template<typename Target>
+				void _bind_operand(Target& target, std::size_t index, const floating_point_operand& operand, bool is_null)
+				{
+					target._bind_floating_point_parameter(index, &operand._t, is_null);
+				}
+
+			template<typename Target>
+				void _bind_operand(Target& target, std::size_t index, const text_operand& operand, bool is_null)
+				{
+					target._bind_text_parameter(index, &operand._t, is_null);
+				}
+
+			template<std::size_t... Is, typename... Members>
+				static void _check_members(const detail::index_sequence<Is...>&, Members...)
+				{
+					static_assert(logic::all_t<detail::is_range_member_compatible<_column_value_type_t<Is>,
+							typename detail::member_object_type<Members>::type>::value...>::value,
+							"from_range() member types do not match the column types");
+				}
+
+			template<typename Target, typename Row, std::size_t... Is, typename... Members>
+				void _bind_members(Target& target, std::size_t offset, const Row& row, const detail::index_sequence<Is...>&, Members... members)
+				{
+					using swallow = int[];  // see interpret_tuple.h
+					(void) swallow{0, (_binder.bind(target, offset + Is, row.*members, _column_value_type_t<Is>{}), 0)...};
+				}
+
+			Db& _db;
+			Insert _statement;
+			std::vector<std::size_t> _chunk_sizes;
+			std::vector<std::unique_ptr<_prepared_t>> _prepared;
+			detail::value_binder_t _binder;
+		};
+
+	template<typename Db, typename Insert>
+		chunked_insert_t<Db, Insert> chunked_insert(Db& db, const Insert& insert, std::size_t max_parameters = 999)
+		{
+			return {db, insert, max_parameters};
+		}
+}
+
+#endif
@@ -36,6 +36,7 @@
 #include <sqlpp11/assignment.h>
 #include <sqlpp11/expression.h>
 #include <sqlpp11/serializer.h>
+#include <sqlpp11/static_sql.h>
 #include <sqlpp11/wrong.h>
 #include <sqlpp11/detail/type_set.h>
 
@@ -119,6 +120,12 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Table, typename ColumnSpec>
+		struct static_sql_t<column_t<Table, ColumnSpec>>
+		{
+			using type = static_sql_cat_t<static_sql_name_of<Table>, char_sequence<'.'>, static_sql_name_of<column_t<Table, ColumnSpec>>>;
+		};
+
 }
 
 #endif
@@ -0,0 +1,427 @@
+/*
+ * columnar_result.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_COLUMNAR_RESULT_H
+#define SQLPP_COLUMNAR_RESULT_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <sqlpp11/wrong.h>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/field_spec.h>
+#include <sqlpp11/result_row.h>
+#include <sqlpp11/text_view.h>
+#include <sqlpp11/type_traits.h>
+#include <sqlpp11/detail/index_sequence.h>
+
+namespace sqlpp
+{
+	struct boolean;
+	struct integral;
+	struct floating_point;
+	struct text;
+
+	// Columnar results: the connector fills up to capacity() rows at once into one
+	// contiguous array per column plus a null bitmap (bit i % 8 of byte i / 8 is set
+	// for NULL in row i). See connector_api/bind_result.h for the connector side.
+	namespace detail
+	{
+		template<typename Value>
+			struct batch_column_base_t
+			{
+				bool is_null(std::size_t row) const
+				{
+					return _null_bitmap[row / 8] & (1u << (row % 8));
+				}
+
+				void _resize(std::size_t capacity)
+				{
+					_values.resize(capacity);
+					_null_bitmap.assign((capacity + 7) / 8, 0);
+				}
+
+				std::vector<Value> _values;
+				std::vector<uint8_t> _null_bitmap;
+			};
+	}
+
+	template<typename ValueType>
+		struct batch_column_t
+		{
+			static_assert(wrong_t<batch_column_t>::value, "Missing specialization for batch_column_t");
+		};
+
+	template<>
+		struct batch_column_t<boolean>: public detail::batch_column_base_t<signed char>
+		{
+			bool operator[](std::size_t row) const
+			{
+				return _values[row];
+			}
+
+			template<typename Target>
+				void _bind(Target& target, std::size_t index)
+				{
+					target._bind_boolean_column(index, _values.data(), _null_bitmap.data(), _values.size());
+				}
+		};
+
+	template<>
+		struct batch_column_t<integral>: public detail::batch_column_base_t<int64_t>
+		{
+			int64_t operator[](std::size_t row) const
+			{
+				return _values[row];
+			}
+
+			template<typename Target>
+				void _bind(Target& target, std::size_t index)
+				{
+					target._bind_integral_column(index, _values.data(), _null_bitmap.data(), _values.size());
+				}
+		};
+
+	template<>
+		struct batch_column_t<floating_point>: public detail::batch_column_base_t<double>
+		{
+			double operator[](std::size_t row) const
+			{
+				return _values[row];
+			}
+
+			template<typename Target>
+				void _bind(Target& target, std::size_t index)
+				{
+					target._bind_floating_point_column(index, _values.data(), _null_bitmap.data(), _values.size());
+				}
+		};
+
+	// Text values point into the connector's buffers, valid until the next batch is fetched
+	template<>
+		struct batch_column_t<text>: public detail::batch_column_base_t<const char*>
+		{
+			text_view_t operator[](std::size_t row) const
+			{
+				return _values[row] ? text_view_t{_values[row], _lengths[row]} : text_view_t{};
+			}
+
+			void _resize(std::size_t capacity)
+			{
+				detail::batch_column_base_t<const char*>::_resize(capacity);
+				_lengths.resize(capacity);
+			}
+
+			template<typename Target>
+				void _bind(Target& target, std::size_t index)
+				{
+					target._bind_text_column(index, _values.data(), _lengths.data(), _null_bitmap.data(), _values.size());
+				}
+
+			std::vector<std::size_t> _lengths;
+		};
+
+	// A field of a row view, refers to a column of the batch
+	template<typename Db, typename FieldSpec>
+		struct batch_field_t
+		{
+			using _column_t = batch_column_t<value_type_of<FieldSpec>>;
+
+			batch_field_t():
+				_column(nullptr),
+				_row(0)
+			{}
+
+			bool is_null() const
+			{
+				return _column->is_null(_row);
+			}
+
+			auto value() const -> decltype(std::declval<const _column_t&>()[0])
+			{
+				if (is_null() and enforce_null_result_treatment_t<Db>::value and not null_is_trivial_value_t<FieldSpec>::value)
+				{
+					throw exception("accessing value of NULL field");
+				}
+				return (*_column)[_row];
+			}
+
+			operator decltype(std::declval<const _column_t&>()[0])() const
+			{
+				return value();
+			}
+
+			const _column_t* _column;
+			std::size_t _row;
+		};
+
+	namespace detail
+	{
+		template<typename Db, std::size_t index, typename FieldSpec>
+			struct batch_column_member: public member_t<FieldSpec, batch_column_t<value_type_of<FieldSpec>>>
+			{
+				using _column = member_t<FieldSpec, batch_column_t<value_type_of<FieldSpec>>>;
+			};
+
+		template<std::size_t index, typename AliasProvider, typename Db, typename FieldSpecs>
+			struct batch_column_member<Db, index, multi_field_spec_t<AliasProvider, FieldSpecs>>
+			{
+				static_assert(wrong_t<batch_column_member>::value, "multi_column is not supported in columnar results");
+			};
+
+		template<typename Db, std::size_t index, typename FieldSpec>
+			struct batch_field_member: public member_t<FieldSpec, batch_field_t<Db, FieldSpec>>
+			{
+				using _field = member_t<FieldSpec, batch_field_t<Db, FieldSpec>>;
+			};
+
+		template<typename Db, typename IndexSequence, typename... FieldSpecs>
+			struct column_batch_impl;
+
+		template<typename Db, std::size_t... Is, typename... FieldSpecs>
+			struct column_batch_impl<Db, index_sequence<Is...>, FieldSpecs...>:
+			public batch_column_member<Db, Is, FieldSpecs>...
+			{
+				void _resize(std::size_t capacity)
+				{
+					using swallow = int[];
+					(void) swallow{0, (batch_column_member<Db, Is, FieldSpecs>::_column::operator()()._resize(capacity), 0)...};
+				}
+
+				template<typename Target>
+					void _bind(Target& target)
+					{
+						using swallow = int[];
+						(void) swallow{0, (batch_column_member<Db, Is, FieldSpecs>::_column::operator()()._bind(target, Is), 0)...};
+					}
+			};
+
+		template<typename Db, typename IndexSequence, typename... FieldSpecs>
+			struct batch_row_impl;
+
+		template<typename Db, std::size_t... Is, typename... FieldSpecs>
+			struct batch_row_impl<Db, index_sequence<Is...>, FieldSpecs...>:
+			public batch_field_member<Db, Is, FieldSpecs>...
+			{
+				template<typename Batch>
+					void _attach(const Batch& batch)
+					{
+						using swallow = int[];
+						(void) swallow{0, (batch_field_member<Db, Is, FieldSpecs>::_field::operator()()._column =
+									&static_cast<const typename batch_column_member<Db, Is, FieldSpecs>::_column&>(batch)(), 0)...};
+					}
+
+				void _set_row(std::size_t row)
+				{
+					using swallow = int[];
+					(void) swallow{0, (batch_field_member<Db, Is, FieldSpecs>::_field::operator()()._row = row, 0)...};
+				}
+			};
+	}
+
+	// Row view into a column_batch_t, fields are accessed by name like in result_row_t
+	template<typename Db, typename... FieldSpecs>
+		struct batch_row_t: public detail::batch_row_impl<Db, detail::make_index_sequence<sizeof...(FieldSpecs)>, FieldSpecs...>
+		{
+			std::size_t _row = 0;
+		};
+
+	// Struct of arrays, columns are accessed by name, e.g. batch.alpha[row]
+	template<typename Db, typename... FieldSpecs>
+		struct column_batch_t: public detail::column_batch_impl<Db, detail::make_index_sequence<sizeof...(FieldSpecs)>, FieldSpecs...>
+		{
+			using _impl = detail::column_batch_impl<Db, detail::make_index_sequence<sizeof...(FieldSpecs)>, FieldSpecs...>;
+			using _row_t = batch_row_t<Db, FieldSpecs...>;
+
+			class iterator
+			{
+			public:
+				iterator(const column_batch_t& batch, std::size_t row)
+				{
+					_row._attach(batch);
+					_set_row(row);
+				}
+
+				const _row_t& operator*() const
+				{
+					return _row;
+				}
+
+				const _row_t* operator->() const
+				{
+					return &_row;
+				}
+
+				bool operator==(const iterator& rhs) const
+				{
+					return _row._row == rhs._row._row;
+				}
+
+				bool operator!=(const iterator& rhs) const
+				{
+					return not (operator==(rhs));
+				}
+
+				void operator++()
+				{
+					_set_row(_row._row + 1);
+				}
+
+			private:
+				void _set_row(std::size_t row)
+				{
+					_row._row = row;
+					_row._set_row(row);
+				}
+
+				_row_t _row;
+			};
+
+			column_batch_t() = default;
+			column_batch_t(const column_batch_t&) = delete;
+			column_batch_t(column_batch_t&&) = default;
+			column_batch_t& operator=(const column_batch_t&) = delete;
+			column_batch_t& operator=(column_batch_t&&) = default;
+			~column_batch_t() = default;
+
+			std::size_t size() const
+			{
+				return _size;
+			}
+
+			bool empty() const
+			{
+				return _size == 0;
+			}
+
+			std::size_t capacity() const
+			{
+				return _capacity;
+			}
+
+			iterator begin() const
+			{
+				return iterator(*this, 0);
+			}
+
+			iterator end() const
+			{
+				return iterator(*this, _size);
+			}
+
+			// The column arrays keep their addresses until the next _resize, so
+			// connectors may bind them once for the whole result
+			void _resize(std::size_t capacity)
+			{
+				_impl::_resize(capacity);
+				_capacity = capacity;
+				_size = 0;
+			}
+
+			// Called by the connector after filling rows [0, size) and their null bits
+			void _set_size(std::size_t size)
+			{
+				_size = size;
+			}
+
+			// Clears the null bitmaps before the connector fills the next batch
+			void _clear_nulls()
+			{
+				_impl::_resize(_capacity);
+			}
+
+			template<typename Target>
+				void _bind(Target& target)
+				{
+					_impl::_bind(target);
+				}
+
+		private:
+			std::size_t _size = 0;
+			std::size_t _capacity = 0;
+		};
+
+	template<typename ResultRow>
+		struct column_batch_of
+		{
+			static_assert(wrong_t<column_batch_of>::value, "columnar results require a select without dynamic columns");
+		};
+
+	template<typename Db, typename... FieldSpecs>
+		struct column_batch_of<result_row_t<Db, FieldSpecs...>>
+		{
+			using type = column_batch_t<Db, FieldSpecs...>;
+		};
+
+	// Counterpart of result_t that fetches whole batches instead of single rows
+	template<typename DbResult, typename Batch>
+		class columnar_result_t
+		{
+			using db_result_t = DbResult;
+			using batch_t = Batch;
+
+			db_result_t _result;
+			batch_t _batch;
+
+		public:
+			columnar_result_t(db_result_t&& result, std::size_t batch_size):
+				_result(std::move(result))
+			{
+				_batch._resize(batch_size);
+			}
+
+			columnar_result_t(const columnar_result_t&) = delete;
+			columnar_result_t(columnar_result_t&&) = default;
+			columnar_result_t& operator=(const columnar_result_t&) = delete;
+			columnar_result_t& operator=(columnar_result_t&&) = default;
+
+			// Fetches the next batch, returns false once the result is exhausted
+			bool next_batch()
+			{
+				_batch._set_size(0);
+				_batch._clear_nulls();
+				_result.next_batch(_batch);
+				return not _batch.empty();
+			}
+
+			const batch_t& batch() const
+			{
+				return _batch;
+			}
+		};
+
+	template<typename Db, typename Select>
+		auto select_columnar(Db& db, const Select& s, std::size_t batch_size = 1024)
+		-> columnar_result_t<decltype(db.select(s)), typename column_batch_of<typename Select::template _result_row_t<Db>>::type>
+		{
+			Select::_run_check::_();
+			return {db.select(s), batch_size};
+		}
+}
+
+#endif
@@ -0,0 +1,485 @@
+/*
+ * connection_pool.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_CONNECTION_POOL_H
+#define SQLPP_CONNECTION_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/prepared_statement_cache.h>
+#include <sqlpp11/transaction.h>
+
+namespace sqlpp
+{
+	struct connection_pool_options_t
+	{
+		// Open connections, idle or checked out
+		std::size_t max_size = 16;
+		// Idle connections are closed after this time, zero disables eviction
+		std::chrono::milliseconds max_idle = std::chrono::minutes(10);
+		// checkout() throws when no connection becomes available in time
+		std::chrono::milliseconds checkout_timeout = std::chrono::seconds(30);
+		// Idle connections are kept in shards, selected by the thread that returns or checks out a connection.
+		// More shards mean less contention between threads.
+		std::size_t shards = 8;
+		// Prefers the connection a thread used last, e.g. to find its prepared statements cached
+		bool thread_affinity = true;
+	};
+
+	namespace detail
+	{
+		// The connector's connection with the pool's bookkeeping
+		template<typename Db>
+			class pooled_db_t: public Db
+			{
+			public:
+				template<typename... Args>
+					pooled_db_t(Args&&... args):
+						Db(std::forward<Args>(args)...)
+				{}
+
+				// Ends the lease of the current user, see detail::connection_lease_t
+				void _end_lease()
+				{
+					_lease->store(false);
+					_lease = std::make_shared<std::atomic<bool>>(true);
+				}
+
+				// Statements prepared on this connection, e.g. by async_executor_t.
+				// Destroyed before the connector's connection, so they are finalized while it is still open.
+				prepared_statement_cache_t<pooled_db_t> _statements;
+				std::shared_ptr<std::atomic<bool>> _lease = std::make_shared<std::atomic<bool>>(true);
+				std::thread::id _last_thread;
+				std::chrono::steady_clock::time_point _returned;
+			};
+
+		// Transactions started on a checked out connection expire when it is returned
+		template<typename Db>
+			struct connection_lease_t<pooled_db_t<Db>>
+			{
+				static std::shared_ptr<const std::atomic<bool>> get(const pooled_db_t<Db>& db)
+				{
+					return db._lease;
+				}
+			};
+
+		template<typename Db, typename = void>
+			struct has_transaction_query_t: std::false_type {};
+
+		template<typename Db>
+			struct has_transaction_query_t<Db, decltype(void(std::declval<const Db&>().is_transaction_active()))>: std::true_type {};
+	}
+
+	template<typename Db>
+		class connection_pool_t;
+
+	// A connection checked out of a pool, returned when destroyed.
+	// Returning a connection rolls back a transaction left open on it. transaction_t and savepoint_t objects
+	// that are still around then do not touch the connection anymore, committing them throws.
+	template<typename Db>
+		class pooled_connection_t
+		{
+			using _pooled_t = detail::pooled_db_t<Db>;
+
+		public:
+			pooled_connection_t(connection_pool_t<Db>& pool, std::unique_ptr<_pooled_t> db):
+				_pool(&pool),
+				_db(std::move(db))
+			{}
+
+			pooled_connection_t(const pooled_connection_t&) = delete;
+			pooled_connection_t(pooled_connection_t&&) = default;
+			pooled_connection_t& operator=(const pooled_connection_t&) = delete;
+			pooled_connection_t& operator=(pooled_connection_t&& rhs)
+			{
+				if (this != &rhs)
+				{
+					release();
+					_pool = rhs._pool;
+					_db = std::move(rhs._db);
+				}
+				return *this;
+			}
+
+			~pooled_connection_t()
+			{
+				release();
+			}
+
+			_pooled_t& operator*() const
+			{
+				return *_db;
+			}
+
+			_pooled_t* operator->() const
+			{
+				return _db.get();
+			}
+
+			explicit operator bool() const
+			{
+				return static_cast<bool>(_db);
+			}
+
+			// Returns the connection to the pool early
+			void release()
+			{
+				if (_db)
+					_pool->_return(std::move(_db));
+			}
+
+			// Closes the connection instead of returning it, e.g. after it failed
+			void discard()
+			{
+				if (_db)
+				{
+					_db.reset();
+					_pool->_discarded();
+				}
+			}
+
+		private:
+			connection_pool_t<Db>* _pool;
+			std::unique_ptr<_pooled_t> _db;
+		};
+
+	// A pool of connections of any connector, e.g.
+	//   connection_pool_t<sqlite3::connection> pool(options, config);
+	//   auto db = pool.checkout();
+	//   (*db)(select(t.alpha).from(t).where(true));
+	//
+	// Connections are created on demand with the constructor arguments given to the pool, up to max_size.
+	// Checkout and return lock one shard of idle connections only. Connections have to be returned
+	// before the pool is destroyed.
+	template<typename Db>
+		class connection_pool_t
+		{
+			friend class pooled_connection_t<Db>;
+			using _pooled_t = detail::pooled_db_t<Db>;
+			using _clock_t = std::chrono::steady_clock;
+
+			struct _shard_t
+			{
+				std::mutex _mutex;
+				// Least recently returned first
+				std::deque<std::unique_ptr<_pooled_t>> _idle;
+			};
+
+		public:
+			using _handle_t = pooled_connection_t<Db>;
+
+			template<typename... Args>
+				connection_pool_t(const connection_pool_options_t& options, Args... args):
+					_options(options),
+					_make(std::bind(&connection_pool_t::_make_connection<Args...>, args...)),
+					_shards(options.shards ? options.shards : 1)
+			{
+				if (options.max_size == 0)
+					throw exception("connection_pool_t requires a max_size greater than zero");
+			}
+
+			connection_pool_t(const connection_pool_t&) = delete;
+			connection_pool_t(connection_pool_t&&) = delete;
+			connection_pool_t& operator=(const connection_pool_t&) = delete;
+			connection_pool_t& operator=(connection_pool_t&&) = delete;
+			~connection_pool_t() = default;
+
+			// Checks connections before they are handed out again, failing connections are closed.
+			// Not synchronized, set it before the first checkout().
+			void set_validator(std::function<bool(Db&)> validator)
+			{
+				_validator = std::move(validator);
+			}
+
+			// An idle connection if there is one, a new connection below max_size, or the next one returned
+			_handle_t checkout()
+			{
+				auto db = _take_idle();
+				if (not db)
+					db = _create();
+				if (db)
+					return {*this, std::move(db)};
+
+				// Registered waiters are woken by returned or closed connections, see _signal()
+				const auto deadline = _clock_t::now() + _options.checkout_timeout;
+				while (true)
+				{
+					std::size_t generation;
+					{
+						std::lock_guard<std::mutex> lock(_wait_mutex);
+						++_waiters;
+						generation = _generation;
+					}
+					db = _take_idle();
+					if (not db)
+						db = _create();
+					std::unique_lock<std::mutex> lock(_wait_mutex);
+					if (db)
+					{
+						--_waiters;
+						return {*this, std::move(db)};
+					}
+					const bool signalled = _available.wait_until(lock, deadline, [this, generation]{ return _generation != generation; });
+					--_waiters;
+					if (not signalled)
+						throw exception("connection_pool_t: no connection available within the checkout timeout");
+				}
+			}
+
+			// Closes connections idle for longer than max_idle
+			void evict_idle()
+			{
+				for (auto& shard : _shards)
+				{
+					std::vector<std::unique_ptr<_pooled_t>> expired;
+					{
+						std::lock_guard<std::mutex> lock(shard._mutex);
+						_evict(shard, expired);
+					}
+					_closed(expired);
+				}
+			}
+
+			// Open connections, idle or checked out
+			std::size_t size() const
+			{
+				return _size;
+			}
+
+		private:
+			template<typename... Args>
+				static std::unique_ptr<_pooled_t> _make_connection(const Args&... args)
+				{
+					return std::unique_ptr<_pooled_t>(new _pooled_t(args...));
+				}
+
+			_shard_t& _shard()
+			{
+				return _shards[std::hash<std::thread::id>()(std::this_thread::get_id()) % _shards.size()];
+			}
+
+			// Moves connections idle for too long out of a locked shard
+			void _evict(_shard_t& shard, std::vector<std::unique_ptr<_pooled_t>>& expired)
+			{
+				if (_options.max_idle.count() == 0)
+					return;
+				const auto oldest = _clock_t::now() - _options.max_idle;
+				while (not shard._idle.empty() and shard._idle.front()->_returned < oldest)
+				{
+					expired.push_back(std::move(shard._idle.front()));
+					shard._idle.pop_front();
+				}
+			}
+
+			std::unique_ptr<_pooled_t> _pop(_shard_t& shard, std::vector<std::unique_ptr<_pooled_t>>& expired)
+			{
+				std::lock_guard<std::mutex> lock(shard._mutex);
+				_evict(shard, expired);
+				if (shard._idle.empty())
+					return nullptr;
+				auto it = shard._idle.end() - 1;
+				if (_options.thread_affinity)
+				{
+					const auto id = std::this_thread::get_id();
+					for (auto candidate = shard._idle.rbegin(); candidate != shard._idle.rend(); ++candidate)
+					{
+						if ((*candidate)->_last_thread == id)
+						{
+							it = candidate.base() - 1;
+							break;
+						}
+					}
+				}
+				auto db = std::move(*it);
+				shard._idle.erase(it);
+				return db;
+			}
+
+			// The own shard first, then the others
+			std::unique_ptr<_pooled_t> _take_idle()
+			{
+				auto& own = _shard();
+				const auto first = static_cast<std::size_t>(&own - _shards.data());
+				for (std::size_t i = 0; i < _shards.size(); ++i)
+				{
+					std::vector<std::unique_ptr<_pooled_t>> expired;
+					auto db = _pop(_shards[(first + i) % _shards.size()], expired);
+					_closed(expired);
+					while (db and _validator and not _validate(*db))
+					{
+						db.reset();
+						_discarded();
+						db = _pop(_shards[(first + i) % _shards.size()], expired);
+						_closed(expired);
+					}
+					if (db)
+						return db;
+				}
+				return nullptr;
+			}
+
+			bool _validate(Db& db)
+			{
+				try
+				{
+					return _validator(db);
+				}
+				catch (...)
+				{
+					return false;
+				}
+			}
+
+			std::unique_ptr<_pooled_t> _create()
+			{
+				auto size = _size.load();
+				do
+				{
+					if (size >= _options.max_size)
+						return nullptr;
+				}
+				while (not _size.compare_exchange_weak(size, size + 1));
+
+				try
+				{
+					return _make();
+				}
+				catch (...)
+				{
+					_discarded();
+					throw;
+				}
+			}
+
+			// The connector tells whether a transaction is open, e.g. one started via a plain Db&.
+			// A connection that cannot be rolled back is not returned to the pool.
+			static bool _reset(_pooled_t& db, const std::true_type&)
+			{
+				try
+				{
+					if (db.is_transaction_active())
+						db.rollback_transaction(false);
+					return not db.is_transaction_active();
+				}
+				catch (...)
+				{
+					return false;
+				}
+			}
+
+			// Otherwise, roll back in any case. This fails if there is no transaction, which is fine.
+			static bool _reset(_pooled_t& db, const std::false_type&)
+			{
+				try
+				{
+					db.rollback_transaction(false);
+				}
+				catch (...)
+				{
+				}
+				return true;
+			}
+
+			void _return(std::unique_ptr<_pooled_t> db)
+			{
+				db->_end_lease();
+				if (not _reset(*db, detail::has_transaction_query_t<Db>{}))
+				{
+					db.reset();
+					_discarded();
+					return;
+				}
+				db->_last_thread = std::this_thread::get_id();
+				db->_returned = _clock_t::now();
+
+				std::vector<std::unique_ptr<_pooled_t>> expired;
+				{
+					auto& shard = _shard();
+					std::lock_guard<std::mutex> lock(shard._mutex);
+					shard._idle.push_back(std::move(db));
+					_evict(shard, expired);
+				}
+				_closed(expired);
+				_signal();
+			}
+
+			// A connection was closed, making room for a new one
+			void _discarded()
+			{
+				--_size;
+				_signal();
+			}
+
+			void _closed(std::vector<std::unique_ptr<_pooled_t>>& expired)
+			{
+				if (expired.empty())
+					return;
+				const auto count = expired.size();
+				expired.clear();
+				_size -= count;
+				_signal();
+			}
+
+			// Wakes threads waiting in checkout(). Waiters register before looking for connections again,
+			// so a connection made available after they looked always finds them registered.
+			void _signal()
+			{
+				if (_waiters.load() == 0)
+					return;
+				{
+					std::lock_guard<std::mutex> lock(_wait_mutex);
+					++_generation;
+				}
+				_available.notify_all();
+			}
+
+			const connection_pool_options_t _options;
+			const std::function<std::unique_ptr<_pooled_t>()> _make;
+			std::function<bool(Db&)> _validator;
+			std::vector<_shard_t> _shards;
+			std::atomic<std::size_t> _size{0};
+
+			std::mutex _wait_mutex;
+			std::condition_variable _available;
+			std::atomic<std::size_t> _waiters{0};
+			std::size_t _generation = 0;
+		};
+}
+
+#endif
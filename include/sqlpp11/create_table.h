@@ -92,6 +92,19 @@ namespace sqlpp
         using type = typename TableType::_primary_key_columns;
     };
 
+    // the primary key column of tables with a single column primary key, void otherwise
+    template <typename TableType, typename KeyColumns = typename get_primary_key_columns<TableType>::type>
+    struct get_single_primary_key_column
+    {
+        using type = void;
+    };
+
+    template< typename TableType, typename Key>
+    struct get_single_primary_key_column<TableType, detail::type_set<Key>>
+    {
+        using type = Key;
+    };
+
     // type that represents a create table statement.
     // all information about the table itself is containted in the TableOrStatement.
     template< typename TableOrStatement, typename AliasType = void>
@@ -165,12 +178,12 @@ namespace sqlpp
 
             std::string represent( const std::string &val)
             {
-                return '\'' + _context.escape( val) + '\'';
+                return '\'' + std::string(_context.escape( val)) + '\'';
             }
 
             std::string represent( const char *val)
             {
-                return std::string("'") + _context.escape( val) + "'";
+                return std::string("'") + std::string(_context.escape( val)) + "'";
             }
 
             std::string represent( const null_t &)
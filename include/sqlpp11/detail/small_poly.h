@@ -0,0 +1,180 @@
+/*
+ * small_poly.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_DETAIL_SMALL_POLY_H
+#define SQLPP_DETAIL_SMALL_POLY_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sqlpp
+{
+	namespace detail
+	{
+		// Owning polymorphic pointer with an inline buffer.
+		//
+		// Implementations that fit into BufferSize bytes and can be moved without
+		// throwing are stored inline, everything else on the heap. Copies are deep,
+		// so there is no reference count. Base has to provide
+		//   virtual Base* _copy_to(void* buffer) const;
+		//   virtual Base* _move_to(void* buffer);
+		//   virtual ~Base();
+		// which small_poly_impl_t implements for derived classes.
+		template<typename Impl>
+			struct small_poly_tag_t
+			{};
+
+		template<typename Base, std::size_t BufferSize>
+			class small_poly_t
+			{
+			public:
+				using _buffer_t = typename std::aligned_storage<BufferSize, alignof(std::max_align_t)>::type;
+
+				template<typename Impl>
+					using _fits_inline = std::integral_constant<bool,
+								sizeof(Impl) <= sizeof(_buffer_t)
+								and alignof(std::max_align_t) % alignof(Impl) == 0
+								and std::is_nothrow_move_constructible<Impl>::value>;
+
+				template<typename Impl, typename Arg>
+					static Base* _construct(void* buffer, Arg&& arg, const std::true_type&)
+					{
+						return ::new (buffer) Impl(std::forward<Arg>(arg));
+					}
+
+				template<typename Impl, typename Arg>
+					static Base* _construct(void*, Arg&& arg, const std::false_type&)
+					{
+						return new Impl(std::forward<Arg>(arg));
+					}
+
+				small_poly_t():
+					_ptr(nullptr)
+				{}
+
+				template<typename Impl, typename Arg>
+					small_poly_t(small_poly_tag_t<Impl>, Arg&& arg):
+						_ptr(_construct<Impl>(&_buffer, std::forward<Arg>(arg), _fits_inline<Impl>{}))
+				{}
+
+				small_poly_t(const small_poly_t& rhs):
+					_ptr(rhs._ptr ? rhs._ptr->_copy_to(&_buffer) : nullptr)
+				{}
+
+				small_poly_t(small_poly_t&& rhs) noexcept:
+					_ptr(nullptr)
+				{
+					_take(rhs);
+				}
+
+				small_poly_t& operator=(const small_poly_t& rhs)
+				{
+					if (this != &rhs)
+					{
+						small_poly_t copy(rhs);
+						_reset();
+						_take(copy);
+					}
+					return *this;
+				}
+
+				small_poly_t& operator=(small_poly_t&& rhs) noexcept
+				{
+					if (this != &rhs)
+					{
+						_reset();
+						_take(rhs);
+					}
+					return *this;
+				}
+
+				~small_poly_t()
+				{
+					_reset();
+				}
+
+				const Base* operator->() const
+				{
+					return _ptr;
+				}
+
+				bool _is_inline() const
+				{
+					return static_cast<const void*>(_ptr) == static_cast<const void*>(&_buffer);
+				}
+
+			private:
+				void _take(small_poly_t& rhs) noexcept
+				{
+					if (rhs._is_inline())
+					{
+						_ptr = rhs._ptr->_move_to(&_buffer);
+						rhs._reset();
+					}
+					else
+					{
+						_ptr = rhs._ptr;
+						rhs._ptr = nullptr;
+					}
+				}
+
+				void _reset() noexcept
+				{
+					if (_is_inline())
+						_ptr->~Base();
+					else
+						delete _ptr;
+					_ptr = nullptr;
+				}
+
+				_buffer_t _buffer;
+				Base* _ptr;
+			};
+
+		template<typename Impl, typename Base, std::size_t BufferSize>
+			struct small_poly_impl_t: public Base
+			{
+				using _poly_t = small_poly_t<Base, BufferSize>;
+
+				Base* _copy_to(void* buffer) const override
+				{
+					return _poly_t::template _construct<Impl>(buffer, static_cast<const Impl&>(*this), typename _poly_t::template _fits_inline<Impl>{});
+				}
+
+				// Only called for inline instances
+				Base* _move_to(void* buffer) override
+				{
+					return ::new (buffer) Impl(std::move(static_cast<Impl&>(*this)));
+				}
+			};
+	}
+}
+
+#endif
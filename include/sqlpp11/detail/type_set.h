@@ -27,6 +27,7 @@
 #ifndef SQLPP_DETAIL_TYPE_SET_H
 #define SQLPP_DETAIL_TYPE_SET_H
 
+#include <cstddef>
 #include <type_traits>
 #include <sqlpp11/wrong.h>
 #include <sqlpp11/logic.h>
@@ -0,0 +1,143 @@
+/*
+ * value_binder.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_DETAIL_VALUE_BINDER_H
+#define SQLPP_DETAIL_VALUE_BINDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <sqlpp11/boolean.h>
+#include <sqlpp11/floating_point.h>
+#include <sqlpp11/integral.h>
+#include <sqlpp11/text.h>
+
+namespace sqlpp
+{
+	namespace detail
+	{
+		template<typename Member>
+			struct member_object_type;
+
+		template<typename T, typename Row>
+			struct member_object_type<T Row::*>
+			{
+				using type = T;
+			};
+
+		// Value types that can be bound to a column of the given value type without loss, i.e. that
+		// convert exactly to int64_t (signed integers, unsigned integers of up to 32 bits) or double
+		// (float, integers of up to 32 bits)
+		template<typename ValueType, typename T>
+			struct is_range_member_compatible: std::false_type
+			{};
+
+		template<>
+			struct is_range_member_compatible<boolean, bool>: std::true_type
+			{};
+
+		template<typename T>
+			struct is_range_member_compatible<integral, T>:
+				std::integral_constant<bool, std::is_integral<T>::value and not std::is_same<T, bool>::value
+					and sizeof(T) <= sizeof(int64_t) and (std::is_signed<T>::value or sizeof(T) <= sizeof(uint32_t))>
+			{};
+
+		template<typename T>
+			struct is_range_member_compatible<floating_point, T>:
+				std::integral_constant<bool, std::is_same<T, float>::value or std::is_same<T, double>::value
+					or (std::is_integral<T>::value and not std::is_same<T, bool>::value and sizeof(T) <= sizeof(uint32_t))>
+			{};
+
+		template<>
+			struct is_range_member_compatible<text, std::string>: std::true_type
+			{};
+
+		// Binds plain C++ values to the parameters of a prepared statement, e.g. for chunked_insert_t.
+		//
+		// Values of the bound type are bound in place, so they have to outlive the execution of the
+		// statement. Values that need a conversion (e.g. int to int64_t) are copied into buffers
+		// indexed by parameter, which have to be sized via resize() before binding.
+		struct value_binder_t
+		{
+			void resize(std::size_t no_of_parameters)
+			{
+				_booleans.resize(no_of_parameters);
+				_integrals.resize(no_of_parameters);
+				_floating_points.resize(no_of_parameters);
+			}
+
+			template<typename Target>
+				void bind(Target& target, std::size_t index, const bool& value, const boolean&, bool is_null = false)
+				{
+					_booleans[index] = static_cast<signed char>(value);
+					target._bind_boolean_parameter(index, &_booleans[index], is_null);
+				}
+
+			template<typename Target>
+				void bind(Target& target, std::size_t index, const int64_t& value, const integral&, bool is_null = false)
+				{
+					target._bind_integral_parameter(index, &value, is_null);
+				}
+
+			template<typename Target, typename T>
+				void bind(Target& target, std::size_t index, const T& value, const integral&, bool is_null = false)
+				{
+					_integrals[index] = static_cast<int64_t>(value);
+					target._bind_integral_parameter(index, &_integrals[index], is_null);
+				}
+
+			template<typename Target>
+				void bind(Target& target, std::size_t index, const double& value, const floating_point&, bool is_null = false)
+				{
+					target._bind_floating_point_parameter(index, &value, is_null);
+				}
+
+			template<typename Target, typename T>
+				void bind(Target& target, std::size_t index, const T& value, const floating_point&, bool is_null = false)
+				{
+					_floating_points[index] = static_cast<double>(value);
+					target._bind_floating_point_parameter(index, &_floating_points[index], is_null);
+				}
+
+			template<typename Target>
+				void bind(Target& target, std::size_t index, const std::string& value, const text&, bool is_null = false)
+				{
+					target._bind_text_parameter(index, &value, is_null);
+				}
+
+		private:
+			std::vector<signed char> _booleans;
+			std::vector<int64_t> _integrals;
+			std::vector<double> _floating_points;
+		};
+	}
+}
+
+#endif
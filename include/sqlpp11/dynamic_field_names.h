@@ -0,0 +1,126 @@
+/*
+ * dynamic_field_names.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_DYNAMIC_FIELD_NAMES_H
+#define SQLPP_DYNAMIC_FIELD_NAMES_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sqlpp
+{
+	// Resolved position of a dynamic column, see dynamic_result_row_t::handle().
+	// Only valid for rows of the statement it was obtained from.
+	struct dynamic_field_handle_t
+	{
+		std::size_t _index;
+	};
+
+	// Names of the dynamic columns of a select plus a name to index lookup.
+	//
+	// The data is shared between the statement and all its result rows, so a row
+	// only copies a pointer. Adding a name to a shared instance copies the data
+	// first, rows of earlier executions are not affected.
+	class dynamic_field_names_t
+	{
+		struct _data_t
+		{
+			std::vector<std::string> _names;
+			std::unordered_map<std::string, std::size_t> _indexes;
+		};
+
+	public:
+		using const_iterator = std::vector<std::string>::const_iterator;
+
+		dynamic_field_names_t() = default;
+		dynamic_field_names_t(const dynamic_field_names_t&) = default;
+		dynamic_field_names_t(dynamic_field_names_t&&) = default;
+		dynamic_field_names_t& operator=(const dynamic_field_names_t&) = default;
+		dynamic_field_names_t& operator=(dynamic_field_names_t&&) = default;
+		~dynamic_field_names_t() = default;
+
+		std::size_t size() const
+		{
+			return _data ? _data->_names.size() : 0;
+		}
+
+		bool empty() const
+		{
+			return size() == 0;
+		}
+
+		const std::string& operator[](std::size_t index) const
+		{
+			return _data->_names[index];
+		}
+
+		const_iterator begin() const
+		{
+			return _data ? _data->_names.cbegin() : _empty().cbegin();
+		}
+
+		const_iterator end() const
+		{
+			return _data ? _data->_names.cend() : _empty().cend();
+		}
+
+		// Returns size() for unknown names. Duplicate names resolve to the first occurrence.
+		std::size_t find(const std::string& name) const
+		{
+			if (not _data)
+				return 0;
+			const auto it = _data->_indexes.find(name);
+			return it == _data->_indexes.end() ? size() : it->second;
+		}
+
+		void push_back(std::string name)
+		{
+			if (not _data)
+				_data = std::make_shared<_data_t>();
+			else if (_data.use_count() > 1)
+				_data = std::make_shared<_data_t>(*_data);
+
+			_data->_indexes.emplace(name, _data->_names.size());
+			_data->_names.push_back(std::move(name));
+		}
+
+	private:
+		static const std::vector<std::string>& _empty()
+		{
+			static const std::vector<std::string> empty;
+			return empty;
+		}
+
+		std::shared_ptr<_data_t> _data;
+	};
+}
+
+#endif
@@ -0,0 +1,287 @@
+/*
+ * dynamic_parameter_list.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_DYNAMIC_PARAMETER_LIST_H
+#define SQLPP_DYNAMIC_PARAMETER_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/literal_bind_list.h>
+#include <sqlpp11/type_traits.h>
+
+namespace sqlpp
+{
+	struct boolean;
+	struct integral;
+	struct floating_point;
+	struct text;
+
+	template<typename ValueType, typename NameType>
+		struct parameter_t;
+
+	namespace detail
+	{
+		template<typename ValueType>
+			struct dynamic_parameter_type;
+
+		template<>
+			struct dynamic_parameter_type<boolean>
+			{
+				static constexpr literal_bind_list_t::type_t value = literal_bind_list_t::type_t::boolean;
+			};
+
+		template<>
+			struct dynamic_parameter_type<integral>
+			{
+				static constexpr literal_bind_list_t::type_t value = literal_bind_list_t::type_t::integral;
+			};
+
+		template<>
+			struct dynamic_parameter_type<floating_point>
+			{
+				static constexpr literal_bind_list_t::type_t value = literal_bind_list_t::type_t::floating_point;
+			};
+
+		template<>
+			struct dynamic_parameter_type<text>
+			{
+				static constexpr literal_bind_list_t::type_t value = literal_bind_list_t::type_t::text;
+			};
+	}
+
+	// Parameters of dynamically added statement parts, e.g. dynamic_where().add(t.beta == parameter(t.beta)).
+	//
+	// Filled when a statement is prepared: Placeholders are numbered in statement order, so the static
+	// parameters of each clause are interleaved with the dynamic ones. The static parameter_list_t is then
+	// bound at the recorded positions and the dynamic values fill the gaps.
+	// Values are set by name, which sets all dynamic parameters of that name. Unset values are bound as NULL.
+	// Parameters of statements nested in dynamic parts are not collected.
+	class dynamic_parameter_list_t
+	{
+	public:
+		using type_t = literal_bind_list_t::type_t;
+
+		std::size_t size() const
+		{
+			return _entries.size();
+		}
+
+		bool empty() const
+		{
+			return _entries.empty();
+		}
+
+		void set(const std::string& name, bool value)
+		{
+			_set(name, type_t::boolean, [value](literal_bind_list_t::entry_t& entry){ entry._boolean = static_cast<signed char>(value); });
+		}
+
+		template<typename T>
+			auto set(const std::string& name, T value)
+			-> typename std::enable_if<std::is_integral<T>::value and not std::is_same<T, bool>::value>::type
+			{
+				_set_number(name, static_cast<int64_t>(value), static_cast<double>(value), true);
+			}
+
+		template<typename T>
+			auto set(const std::string& name, T value)
+			-> typename std::enable_if<std::is_floating_point<T>::value>::type
+			{
+				_set_number(name, 0, static_cast<double>(value), false);
+			}
+
+		void set(const std::string& name, const std::string& value)
+		{
+			_set(name, type_t::text, [&value](literal_bind_list_t::entry_t& entry){ entry._text = value; });
+		}
+
+		void set(const std::string& name, const char* value)
+		{
+			set(name, std::string(value));
+		}
+
+		void set_null(const std::string& name)
+		{
+			bool found = false;
+			for (auto& entry : _entries)
+			{
+				if (entry._name == name)
+				{
+					entry._is_null = true;
+					found = true;
+				}
+			}
+			if (not found)
+				throw exception("sqlpp::dynamic_parameter_list_t: unknown parameter " + name);
+		}
+
+		// Visitor interface, see statement_t::_visit_dynamic_parts()
+		void _visit_clause(std::size_t no_of_static_parameters)
+		{
+			for (std::size_t i = 0; i < no_of_static_parameters; ++i)
+				_static_positions.push_back(_next_position++);
+		}
+
+		template<typename Part>
+			void _visit_part(const Part& part)
+			{
+				part._collect_parameters(*this);
+			}
+
+		template<typename... Parameter>
+			void _add_parameters(const detail::type_vector<Parameter...>&)
+			{
+				using swallow = int[];  // see interpret_tuple.h
+				(void) swallow{0, (_add_parameter(static_cast<const Parameter*>(nullptr)), 0)...};
+			}
+
+		template<typename StaticParameters, typename Target>
+			void _bind(const StaticParameters& params, Target& target) const
+			{
+				if (_entries.empty())
+				{
+					params._bind(target);
+					return;
+				}
+				params._bind(target, _static_positions.data());
+				for (const auto& entry : _entries)
+					literal_bind_list_t::_bind_entry(target, entry._position, entry._value, entry._is_null);
+			}
+
+		// Dynamic values are the same for every row, so they are bound with a stride of zero
+		template<typename StaticParameters, typename Target>
+			void _bind_array(const StaticParameters& rows, Target& target, std::size_t stride, std::size_t count) const
+			{
+				if (_entries.empty())
+				{
+					rows._bind_array(target, stride, count);
+					return;
+				}
+				rows._bind_array(target, _static_positions.data(), stride, count);
+				for (const auto& entry : _entries)
+				{
+					const auto& value = entry._value;
+					switch (value._type)
+					{
+					case type_t::boolean:
+						target._bind_boolean_parameter_array(entry._position, &value._boolean, &entry._is_null, 0, count);
+						break;
+					case type_t::integral:
+						target._bind_integral_parameter_array(entry._position, &value._integral, &entry._is_null, 0, count);
+						break;
+					case type_t::floating_point:
+						target._bind_floating_point_parameter_array(entry._position, &value._floating_point, &entry._is_null, 0, count);
+						break;
+					case type_t::text:
+						target._bind_text_parameter_array(entry._position, &value._text, &entry._is_null, 0, count);
+						break;
+					}
+				}
+			}
+
+	private:
+		struct entry_t
+		{
+			std::string _name;
+			std::size_t _position;
+			bool _is_null;
+			literal_bind_list_t::entry_t _value;
+		};
+
+		template<typename ValueType, typename NameType>
+			void _add_parameter(const parameter_t<ValueType, NameType>*)
+			{
+				_entries.push_back({name_of<NameType>::char_ptr(), _next_position++, true,
+						{detail::dynamic_parameter_type<ValueType>::value, 0, 0, 0.0, {}}});
+			}
+
+		template<typename Assign>
+			void _set(const std::string& name, type_t type, const Assign& assign)
+			{
+				bool found = false;
+				for (auto& entry : _entries)
+				{
+					if (entry._name != name)
+						continue;
+					if (entry._value._type != type)
+						throw exception("sqlpp::dynamic_parameter_list_t: type mismatch for parameter " + name);
+					assign(entry._value);
+					entry._is_null = false;
+					found = true;
+				}
+				if (not found)
+					throw exception("sqlpp::dynamic_parameter_list_t: unknown parameter " + name);
+			}
+
+		// Integral values may be assigned to floating point parameters, too
+		void _set_number(const std::string& name, int64_t integral_value, double floating_point_value, bool is_integral)
+		{
+			bool found = false;
+			for (auto& entry : _entries)
+			{
+				if (entry._name != name)
+					continue;
+				if (is_integral and entry._value._type == type_t::integral)
+					entry._value._integral = integral_value;
+				else if (entry._value._type == type_t::floating_point)
+					entry._value._floating_point = floating_point_value;
+				else
+					throw exception("sqlpp::dynamic_parameter_list_t: type mismatch for parameter " + name);
+				entry._is_null = false;
+				found = true;
+			}
+			if (not found)
+				throw exception("sqlpp::dynamic_parameter_list_t: unknown parameter " + name);
+		}
+
+		std::size_t _next_position = 0;
+		std::vector<std::size_t> _static_positions;
+		std::vector<entry_t> _entries;
+	};
+
+	// Only counts the parameters of dynamic statement parts, see statement_t::_get_no_of_parameters()
+	struct dynamic_parameter_counter_t
+	{
+		void _visit_clause(std::size_t)
+		{}
+
+		template<typename Part>
+			void _visit_part(const Part& part)
+			{
+				_count += part._no_of_parameters;
+			}
+
+		std::size_t _count = 0;
+	};
+}
+
+#endif
@@ -35,9 +35,101 @@
 #include <sqlpp11/expression_fwd.h>
 #include <sqlpp11/serializer.h>
 #include <sqlpp11/wrap_operand.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
+	// Operator names as used by the serializers above
+	template<>
+		struct static_sql_t<op::less>
+		{
+			using type = char_sequence<'<'>;
+		};
+
+	template<>
+		struct static_sql_t<op::less_equal>
+		{
+			using type = char_sequence<'<', '='>;
+		};
+
+	template<>
+		struct static_sql_t<op::greater_equal>
+		{
+			using type = char_sequence<'>', '='>;
+		};
+
+	template<>
+		struct static_sql_t<op::greater>
+		{
+			using type = char_sequence<'>'>;
+		};
+
+	template<>
+		struct static_sql_t<op::logical_or>
+		{
+			using type = char_sequence<' ', 'O', 'R', ' '>;
+		};
+
+	template<>
+		struct static_sql_t<op::logical_and>
+		{
+			using type = char_sequence<' ', 'A', 'N', 'D', ' '>;
+		};
+
+	template<typename ValueType>
+		struct static_sql_t<op::plus<ValueType>>
+		{
+			using type = char_sequence<'+'>;
+		};
+
+	template<typename ValueType>
+		struct static_sql_t<op::minus<ValueType>>
+		{
+			using type = char_sequence<'-'>;
+		};
+
+	template<typename ValueType>
+		struct static_sql_t<op::multiplies<ValueType>>
+		{
+			using type = char_sequence<'*'>;
+		};
+
+	template<>
+		struct static_sql_t<op::divides>
+		{
+			using type = char_sequence<'/'>;
+		};
+
+	template<>
+		struct static_sql_t<op::modulus>
+		{
+			using type = char_sequence<'%'>;
+		};
+
+	template<typename ValueType>
+		struct static_sql_t<op::unary_minus<ValueType>>
+		{
+			using type = char_sequence<'-'>;
+		};
+
+	template<typename ValueType>
+		struct static_sql_t<op::unary_plus<ValueType>>
+		{
+			using type = char_sequence<'+'>;
+		};
+
+	template<typename ValueType>
+		struct static_sql_t<op::bitwise_and<ValueType>>
+		{
+			using type = char_sequence<'&'>;
+		};
+
+	template<typename ValueType>
+		struct static_sql_t<op::bitwise_or<ValueType>>
+		{
+			using type = char_sequence<'|'>;
+		};
+
 	template<typename Lhs, typename Rhs>
 		struct binary_expression_t<Lhs, op::equal_to, Rhs>:
 			public expression_operators<binary_expression_t<Lhs, op::equal_to, Rhs>, boolean>,
@@ -87,6 +179,14 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Lhs, typename Rhs>
+		struct static_sql_t<binary_expression_t<Lhs, op::equal_to, Rhs>>
+		{
+			using T = binary_expression_t<Lhs, op::equal_to, Rhs>;
+			using type = static_sql_cat_t<char_sequence<'('>, static_sql_operand_of<typename T::_lhs_t>, char_sequence<'='>,
+						static_sql_operand_of<typename T::_rhs_t>, char_sequence<')'>>;
+		};
+
 	template<typename Lhs, typename Rhs>
 		struct binary_expression_t<Lhs, op::not_equal_to, Rhs>:
 			public expression_operators<binary_expression_t<Lhs, op::not_equal_to, Rhs>, boolean>,
@@ -136,6 +236,14 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Lhs, typename Rhs>
+		struct static_sql_t<binary_expression_t<Lhs, op::not_equal_to, Rhs>>
+		{
+			using T = binary_expression_t<Lhs, op::not_equal_to, Rhs>;
+			using type = static_sql_cat_t<char_sequence<'('>, static_sql_operand_of<typename T::_lhs_t>, char_sequence<'!', '='>,
+						static_sql_operand_of<typename T::_rhs_t>, char_sequence<')'>>;
+		};
+
 	template<typename Rhs>
 		struct unary_expression_t<op::logical_not, Rhs>:
 			public expression_operators<unary_expression_t<op::logical_not, Rhs>, boolean>,
@@ -182,6 +290,16 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Rhs>
+		struct static_sql_t<unary_expression_t<op::logical_not, Rhs>>
+		{
+			static constexpr const char _is_null[] = " IS NULL ";
+			static constexpr const char _not[] = "NOT ";
+			using type = typename std::conditional<trivial_value_is_null_t<Rhs>::value,
+						static_sql_cat_t<char_sequence<'('>, static_sql_operand_of<Rhs>, make_static_sql_literal<sizeof(_is_null), _is_null>, char_sequence<')'>>,
+						static_sql_cat_t<char_sequence<'('>, make_static_sql_literal<sizeof(_not), _not>, static_sql_operand_of<Rhs>, char_sequence<')'>>>::type;
+		};
+
 	template<typename Lhs, typename O, typename Rhs>
 		struct binary_expression_t:
 			public expression_operators<binary_expression_t<Lhs, O, Rhs>, value_type_of<O>>,
@@ -222,6 +340,12 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Lhs, typename O, typename Rhs>
+		struct static_sql_t<binary_expression_t<Lhs, O, Rhs>>
+		{
+			using type = static_sql_cat_t<char_sequence<'('>, static_sql_operand_of<Lhs>, static_sql_of<O>, static_sql_operand_of<Rhs>, char_sequence<')'>>;
+		};
+
 	template<typename O, typename Rhs>
 		struct unary_expression_t:
 			public expression_operators<unary_expression_t<O, Rhs>, value_type_of<O>>,
@@ -258,6 +382,12 @@ namespace sqlpp
 				return context;
 			}
 		};
+
+	template<typename O, typename Rhs>
+		struct static_sql_t<unary_expression_t<O, Rhs>>
+		{
+			using type = static_sql_cat_t<char_sequence<'('>, static_sql_of<O>, static_sql_operand_of<Rhs>, char_sequence<')'>>;
+		};
 }
 
 #endif
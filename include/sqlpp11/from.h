@@ -35,6 +35,7 @@
 #include <sqlpp11/logic.h>
 #include <sqlpp11/detail/sum.h>
 #include <sqlpp11/policy_update.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
@@ -204,6 +205,16 @@ namespace sqlpp
 			};
 	};
 
+	template<typename Database, typename... Tables>
+		struct dynamic_parts_t<from_data_t<Database, Tables...>>
+		{
+			template<typename Visitor>
+				static void _(const from_data_t<Database, Tables...>& t, Visitor& visitor)
+				{
+					t._dynamic_tables._visit(visitor);
+				}
+		};
+
 	// Interpreters
 	template<typename Context, typename Database, typename... Tables>
 		struct serializer_t<Context, from_data_t<Database, Tables...>>
@@ -224,6 +235,22 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Database, typename... Tables>
+		struct static_part_of_t<from_data_t<Database, Tables...>>
+		{
+			using type = from_data_t<void, Tables...>;
+		};
+
+	template<typename... Tables>
+		struct static_sql_t<from_data_t<void, Tables...>>
+		{
+			static constexpr const char _literal[] = " FROM ";
+			using type = typename std::conditional<sizeof...(Tables) == 0,
+						char_sequence<>,
+						static_sql_cat_t<make_static_sql_literal<sizeof(_literal), _literal>,
+							static_sql_join_t<char_sequence<','>, static_sql_operand_of<Tables>...>>>::type;
+		};
+
 	template<typename... T>
 		auto from(T&&... t) -> decltype(statement_t<void, no_from_t>().from(std::forward<T>(t)...))
 		{
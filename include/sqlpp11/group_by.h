@@ -34,6 +34,7 @@
 #include <sqlpp11/interpretable_list.h>
 #include <sqlpp11/policy_update.h>
 #include <sqlpp11/logic.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
@@ -215,6 +216,16 @@ namespace sqlpp
 			};
 	};
 
+	template<typename Database, typename... Expressions>
+		struct dynamic_parts_t<group_by_data_t<Database, Expressions...>>
+		{
+			template<typename Visitor>
+				static void _(const group_by_data_t<Database, Expressions...>& t, Visitor& visitor)
+				{
+					t._dynamic_expressions._visit(visitor);
+				}
+		};
+
 	// Interpreters
 	template<typename Context, typename Database, typename... Expressions>
 		struct serializer_t<Context, group_by_data_t<Database, Expressions...>>
@@ -234,6 +245,22 @@ namespace sqlpp
 				return context;
 			}
 		};
+
+	template<typename Database, typename... Expressions>
+		struct static_part_of_t<group_by_data_t<Database, Expressions...>>
+		{
+			using type = group_by_data_t<void, Expressions...>;
+		};
+
+	template<typename... Expressions>
+		struct static_sql_t<group_by_data_t<void, Expressions...>>
+		{
+			static constexpr const char _literal[] = " GROUP BY ";
+			using type = typename std::conditional<sizeof...(Expressions) == 0,
+						char_sequence<>,
+						static_sql_cat_t<make_static_sql_literal<sizeof(_literal), _literal>,
+							static_sql_join_t<char_sequence<','>, static_sql_operand_of<Expressions>...>>>::type;
+		};
 }
 
 #endif
@@ -33,6 +33,7 @@
 #include <sqlpp11/interpretable_list.h>
 #include <sqlpp11/policy_update.h>
 #include <sqlpp11/logic.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
@@ -213,6 +214,16 @@ namespace sqlpp
 			};
 	};
 
+	template<typename Database, typename... Expressions>
+		struct dynamic_parts_t<having_data_t<Database, Expressions...>>
+		{
+			template<typename Visitor>
+				static void _(const having_data_t<Database, Expressions...>& t, Visitor& visitor)
+				{
+					t._dynamic_expressions._visit(visitor);
+				}
+		};
+
 	// Interpreters
 	template<typename Context, typename Database, typename... Expressions>
 		struct serializer_t<Context, having_data_t<Database, Expressions...>>
@@ -232,6 +243,23 @@ namespace sqlpp
 				return context;
 			}
 		};
+
+	template<typename Database, typename... Expressions>
+		struct static_part_of_t<having_data_t<Database, Expressions...>>
+		{
+			using type = having_data_t<void, Expressions...>;
+		};
+
+	template<typename... Expressions>
+		struct static_sql_t<having_data_t<void, Expressions...>>
+		{
+			static constexpr const char _literal[] = " HAVING ";
+			static constexpr const char _separator[] = " AND ";
+			using type = typename std::conditional<sizeof...(Expressions) == 0,
+						char_sequence<>,
+						static_sql_cat_t<make_static_sql_literal<sizeof(_literal), _literal>,
+							static_sql_join_t<make_static_sql_literal<sizeof(_separator), _separator>, static_sql_operand_of<Expressions>...>>>::type;
+		};
 }
 
 #endif
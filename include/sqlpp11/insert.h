@@ -36,6 +36,8 @@
 #include <sqlpp11/noop.h>
 #include <sqlpp11/into.h>
 #include <sqlpp11/insert_value_list.h>
+#include <sqlpp11/on_conflict.h>
+#include <sqlpp11/returning.h>
 
 namespace sqlpp
 {
@@ -75,14 +77,14 @@ namespace sqlpp
 					auto _prepare(Db& db, const Composite& composite) const
 					-> prepared_insert_t<Db, Composite>
 					{
-						return {{}, db.prepare_insert(composite)};
+						return {{}, {}, db.prepare_insert(composite)};
 					}
 
 				template<typename Db>
 					auto _prepare(Db& db) const
 					-> prepared_insert_t<Db, _statement_t>
 					{
-						return {{}, db.prepare_insert(_get_statement())};
+						return {{}, _get_statement()._get_dynamic_parameters(), db.prepare_insert(_get_statement())};
 					}
 			};
 	};
@@ -105,7 +107,9 @@ namespace sqlpp
 		using blank_insert_t = statement_t<Database,
 					insert_t,
 					no_into_t,
-					no_insert_value_list_t>;
+					no_insert_value_list_t,
+					no_on_conflict_t,
+					no_returning_t>;
 
 	inline auto insert()
 		-> blank_insert_t<void>
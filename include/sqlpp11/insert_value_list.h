@@ -33,9 +33,13 @@
 #include <sqlpp11/interpretable_list.h>
 #include <sqlpp11/interpret_tuple.h>
 #include <sqlpp11/insert_value.h>
+#include <sqlpp11/parameter.h>
 #include <sqlpp11/simple_column.h>
 #include <sqlpp11/no_data.h>
 #include <sqlpp11/policy_update.h>
+#include <sqlpp11/field_spec.h>
+#include <sqlpp11/result_row_fwd.h>
+#include <sqlpp11/detail/get_first.h>
 
 namespace sqlpp
 {
@@ -55,6 +59,46 @@ namespace sqlpp
 				using set_columns = detail::make_type_set_t<First, Columns...>;
 				static constexpr bool value = detail::is_subset_of<required_columns, set_columns>::value;
 			};
+
+		template<typename Column, typename FieldSpec>
+			struct is_insert_select_field_compatible
+			{
+				static constexpr bool value = false;
+			};
+
+		template<typename Column, typename NameType, typename ValueType, bool CanBeNull, bool NullIsTrivialValue>
+			struct is_insert_select_field_compatible<Column, field_spec_t<NameType, ValueType, CanBeNull, NullIsTrivialValue>>
+			{
+				static constexpr bool value = value_type_of<Column>::template _is_valid_operand<field_spec_t<NameType, ValueType, CanBeNull, NullIsTrivialValue>>::value;
+			};
+
+		template<typename ResultRow, typename ColumnVector, typename Enable = void>
+			struct is_insert_select_row_compatible
+			{
+				static constexpr bool value = false;
+			};
+
+		template<typename Db, typename... FieldSpecs, typename... Columns>
+			struct is_insert_select_row_compatible<result_row_t<Db, FieldSpecs...>, type_vector<Columns...>,
+				typename std::enable_if<sizeof...(FieldSpecs) == sizeof...(Columns)>::type>
+			{
+				static constexpr bool value = logic::all_t<is_insert_select_field_compatible<Columns, FieldSpecs>::value...>::value;
+			};
+
+		// The selected fields have to match the inserted columns in number and value type, like an assignment would
+		template<typename Select, typename ColumnVector, typename Enable = void>
+			struct is_insert_select_compatible
+			{
+				static constexpr bool value = false;
+			};
+
+		template<typename Select, typename... Columns>
+			struct is_insert_select_compatible<Select, type_vector<Columns...>,
+				typename std::enable_if<is_select_t<Select>::value and Select::_can_be_used_as_table()>::type>
+			{
+				using _result_row_t = typename Select::template _result_methods_t<Select>::template _result_row_t<void>;
+				static constexpr bool value = is_insert_select_row_compatible<_result_row_t, type_vector<Columns...>>::value;
+			};
 	}
 
 	struct insert_default_values_data_t
@@ -212,6 +256,76 @@ namespace sqlpp
 
 		};
 
+	struct assert_no_unknown_tables_in_column_list_t
+	{
+		using type = std::false_type;
+
+		template<typename T = void>
+		static void _()
+		{
+			static_assert(wrong_t<T>::value, "at least one column requires a table which is otherwise not known in the statement");
+		}
+	};
+
+	template<typename Select, typename... Columns>
+		struct insert_select_data_t
+		{
+			insert_select_data_t(std::tuple<simple_column_t<Columns>...> columns, Select select):
+				_columns(columns),
+				_select(select)
+			{}
+
+			insert_select_data_t(const insert_select_data_t&) = default;
+			insert_select_data_t(insert_select_data_t&&) = default;
+			insert_select_data_t& operator=(const insert_select_data_t&) = default;
+			insert_select_data_t& operator=(insert_select_data_t&&) = default;
+			~insert_select_data_t() = default;
+
+			std::tuple<simple_column_t<Columns>...> _columns;
+			Select _select;
+		};
+
+	// COLUMN LIST AND SELECT
+	template<typename Select, typename... Columns>
+		struct insert_select_t
+		{
+			using _traits = make_traits<no_value_t, tag::is_column_list>;
+			using _nodes = detail::type_vector<Columns..., Select>;
+
+			// Data
+			using _data_t = insert_select_data_t<Select, Columns...>;
+
+			// Member implementation with data and methods
+			template <typename Policies>
+				struct _impl_t
+				{
+					_data_t _data;
+				};
+
+			// Base template to be inherited by the statement
+			template<typename Policies>
+				struct _base_t
+				{
+					using _data_t = insert_select_data_t<Select, Columns...>;
+
+					_impl_t<Policies> insert_select;
+					_impl_t<Policies>& operator()() { return insert_select; }
+					const _impl_t<Policies>& operator()() const { return insert_select; }
+
+					template<typename T>
+						static auto _get_member(T t) -> decltype(t.insert_select)
+						{
+							return t.insert_select;
+						}
+
+					using _consistency_check = detail::get_first_if<is_inconsistent_t, consistent_t,
+								typename Select::_consistency_check,
+								typename std::conditional<Policies::template _no_unknown_tables<insert_select_t>::value,
+									consistent_t,
+									assert_no_unknown_tables_in_column_list_t>::type>;
+				};
+		};
+
 	template<typename... Columns>
 		struct column_list_data_t
 		{
@@ -228,19 +342,9 @@ namespace sqlpp
 			using _value_tuple_t = std::tuple<insert_value_t<Columns>...>;
 			std::tuple<simple_column_t<Columns>...> _columns;
 			std::vector<_value_tuple_t> _insert_values;
+			std::size_t _placeholder_rows = 0; // if set, serialized as that many rows of '?' instead of _insert_values, see chunked_insert.h
 		};
 
-	struct assert_no_unknown_tables_in_column_list_t
-	{
-		using type = std::false_type;
-
-		template<typename T = void>
-		static void _()
-		{
-			static_assert(wrong_t<T>::value, "at least one column requires a table which is otherwise not known in the statement");
-		}
-	};
-
 	template<typename... Columns>
 		struct column_list_t
 		{
@@ -304,6 +408,36 @@ namespace sqlpp
 					using _consistency_check = typename std::conditional<Policies::template _no_unknown_tables<column_list_t>::value,
 								consistent_t,
 								assert_no_unknown_tables_in_column_list_t>::type;
+
+					template<typename Select>
+						using _select_check = detail::is_insert_select_compatible<Select, detail::type_vector<Columns...>>;
+
+					template<typename Check, typename T>
+						using _new_statement_t = new_statement_t<Check::value, Policies, column_list_t, T>;
+
+					// INSERT INTO ... (columns) SELECT ..., replaces values added so far
+					template<typename Select>
+						auto select(Select statement) const
+						-> _new_statement_t<_select_check<Select>, insert_select_t<Select, Columns...>>
+						{
+							static_assert(is_select_t<Select>::value, "select() requires a select statement");
+							static_assert(_select_check<Select>::value, "selected columns do not match columns() in number or value type, or the select is incomplete");
+
+							return _select_impl(std::integral_constant<bool, _select_check<Select>::value>{}, statement);
+						}
+
+				private:
+					template<typename Select>
+						auto _select_impl(const std::false_type&, Select statement) const
+						-> bad_statement;
+
+					template<typename Select>
+						auto _select_impl(const std::true_type&, Select statement) const
+						-> _new_statement_t<std::true_type, insert_select_t<Select, Columns...>>
+						{
+							static_assert(std::is_same<typename Select::_policies_t::_database_t, void>::value, "select() requires a static select statement");
+							return { static_cast<const derived_statement_t<Policies>&>(*this), insert_select_data_t<Select, Columns...>{values._data._columns, statement} };
+						}
 				};
 		};
 
@@ -464,6 +598,20 @@ namespace sqlpp
 				interpret_tuple(t._columns, ",", context);
 				context << ")";
 				context << " VALUES ";
+				if (t._placeholder_rows)
+				{
+					// Serialized like parameters, so that contexts can number them
+					const std::tuple<parameter_t<value_type_of<Columns>, Columns>...> placeholders{};
+					for (std::size_t i = 0; i < t._placeholder_rows; ++i)
+					{
+						if (i)
+							context << ',';
+						context << '(';
+						interpret_tuple(placeholders, ",", context);
+						context << ')';
+					}
+					return context;
+				}
 				bool first = true;
 				for (const auto& row : t._insert_values)
 				{
@@ -480,6 +628,33 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Context, typename Select, typename... Columns>
+		struct serializer_t<Context, insert_select_data_t<Select, Columns...>>
+		{
+			using _serialize_check = serialize_check_of<Context, Columns..., Select>;
+			using T = insert_select_data_t<Select, Columns...>;
+
+			static Context& _(const T& t, Context& context)
+			{
+				context << " (";
+				interpret_tuple(t._columns, ",", context);
+				context << ") ";
+				serialize(t._select, context);
+				return context;
+			}
+		};
+
+	template<typename Database, typename... Assignments>
+		struct dynamic_parts_t<insert_list_data_t<Database, Assignments...>>
+		{
+			template<typename Visitor>
+				static void _(const insert_list_data_t<Database, Assignments...>& t, Visitor& visitor)
+				{
+					t._dynamic_columns._visit(visitor);
+					t._dynamic_values._visit(visitor);
+				}
+		};
+
 	template<typename Context, typename Database, typename... Assignments>
 		struct serializer_t<Context, insert_list_data_t<Database, Assignments...>>
 		{
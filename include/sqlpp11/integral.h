@@ -113,6 +113,12 @@ namespace sqlpp
 				target._bind_integral_parameter(index, &_value, _is_null);
 			}
 
+		template<typename Target>
+			void _bind_array(Target& target, size_t index, size_t stride, size_t count) const
+			{
+				target._bind_integral_parameter_array(index, &_value, &_is_null, stride, count);
+			}
+
 	private:
 		_cpp_value_type _value;
 		bool _is_null;
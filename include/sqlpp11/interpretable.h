@@ -27,11 +27,14 @@
 #ifndef SQLPP_INTERPRETABLE_H
 #define SQLPP_INTERPRETABLE_H
 
-#include <memory>
+#include <typeinfo>
 #include <sqlpp11/serializer_context.h>
 #include <sqlpp11/parameter_list.h>
+#include <sqlpp11/dynamic_parameter_list.h>
+#include <sqlpp11/static_sql.h>
 #include <sqlpp11/serialize.h>
 #include <sqlpp11/interpret.h>
+#include <sqlpp11/detail/small_poly.h>
 
 namespace sqlpp
 {
@@ -44,7 +47,9 @@ namespace sqlpp
 			template<typename T>
 				interpretable_t(T t):
 					_requires_braces(requires_braces_t<T>::value),
-					_impl(std::make_shared<_impl_t<T>>(t))
+					_has_static_sql(has_static_sql_t<T>::value),
+					_no_of_parameters(detail::type_vector_size<parameters_of<T>>::value),
+					_impl(detail::small_poly_tag_t<_impl_t<T>>{}, t)
 			{}
 
 			interpretable_t(const interpretable_t&) = default;
@@ -72,20 +77,40 @@ namespace sqlpp
 				return _impl->interpret(context);
 			}
 
+			void _collect_parameters(dynamic_parameter_list_t& list) const
+			{
+				if (_no_of_parameters)
+					_impl->_collect_parameters(list);
+			}
+
+			const std::type_info& _get_type() const
+			{
+				return _impl->_get_type();
+			}
+
 			bool _requires_braces;
+			bool _has_static_sql;
+			std::size_t _no_of_parameters;
 
 		private:
 			struct _impl_base
 			{
+				virtual ~_impl_base() = default;
+				virtual _impl_base* _copy_to(void* buffer) const = 0;
+				virtual _impl_base* _move_to(void* buffer) = 0;
 				virtual serializer_context_t& serialize(serializer_context_t& context) const = 0;
 				virtual _serializer_context_t& db_serialize(_serializer_context_t& context) const = 0;
 				virtual _interpreter_context_t& interpret(_interpreter_context_t& context) const = 0;
+				virtual void _collect_parameters(dynamic_parameter_list_t& list) const = 0;
+				virtual const std::type_info& _get_type() const = 0;
 			};
 
+			// Large enough for a comparison of a column with a text literal
+			static constexpr std::size_t _buffer_size = 64;
+
 			template<typename T>
-				struct _impl_t: public _impl_base
+				struct _impl_t: public detail::small_poly_impl_t<_impl_t<T>, _impl_base, _buffer_size>
 			{
-				static_assert(not make_parameter_list_t<T>::size::value, "parameters not supported in dynamic statement parts");
 				_impl_t(T t):
 					_t(t)
 				{}
@@ -108,10 +133,20 @@ namespace sqlpp
 					return context;
 				}
 
+				void _collect_parameters(dynamic_parameter_list_t& list) const
+				{
+					list._add_parameters(parameters_of<T>{});
+				}
+
+				const std::type_info& _get_type() const
+				{
+					return typeid(T);
+				}
+
 				T _t;
 			};
 
-			std::shared_ptr<const _impl_base> _impl;
+			detail::small_poly_t<_impl_base, _buffer_size> _impl;
 		};
 
 	template<typename Context, typename Database>
@@ -50,9 +50,19 @@ namespace sqlpp
 			template<typename Expr>
 				void emplace_back(Expr expr)
 				{
+					// entries are stored inline, start with room for a few of them
+					if (_serializables.empty())
+						_serializables.reserve(8);
 					_serializables.emplace_back(expr);
 				}
 
+			template<typename Visitor>
+				void _visit(Visitor& visitor) const
+				{
+					for (const auto& entry : _serializables)
+						visitor._visit_part(entry);
+				}
+
 		};
 
 	template<>
@@ -68,6 +78,21 @@ namespace sqlpp
 				return true;
 			}
 
+			template<typename Visitor>
+				void _visit(Visitor&) const
+				{}
+
+		};
+
+	// Hands the dynamic parts of a clause's data to a visitor, in serialization order:
+	//   visitor._visit_part(part) is called with each interpretable_t or named_interpretable_t.
+	// Specialized next to the serializer of each data type with dynamic parts.
+	template<typename Data>
+		struct dynamic_parts_t
+		{
+			template<typename Visitor>
+				static void _(const Data&, Visitor&)
+				{}
 		};
 
 	template<typename Context, typename List>
@@ -79,7 +104,7 @@ namespace sqlpp
 				static Context& _(const T& t, const Separator& separator, Context& context)
 				{
 					bool first = true;
-					for (const auto entry : t._serializables)
+					for (const auto& entry : t._serializables)
 					{
 						if (not first)
 						{
@@ -0,0 +1,474 @@
+/*
+ * keyset_pager.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_KEYSET_PAGER_H
+#define SQLPP_KEYSET_PAGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <sqlpp11/type_traits.h>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/parameter.h>
+#include <sqlpp11/sort_order.h>
+#include <sqlpp11/where.h>
+#include <sqlpp11/order_by.h>
+#include <sqlpp11/limit.h>
+#include <sqlpp11/offset.h>
+#include <sqlpp11/field_spec.h>
+#include <sqlpp11/result_row.h>
+#include <sqlpp11/statement.h>
+#include <sqlpp11/detail/get_first.h>
+#include <sqlpp11/detail/index_sequence.h>
+#include <sqlpp11/detail/type_set.h>
+
+namespace sqlpp
+{
+	namespace detail
+	{
+		// Names the parameters of the seek predicate, one per use of a sort column
+		template<std::size_t Index, std::size_t Use>
+			struct keyset_parameter_name_t
+			{
+				struct _alias_t
+				{
+					template<typename T>
+						struct _member_t
+						{
+							T keyset;
+							T& operator()() { return keyset; }
+							const T& operator()() const { return keyset; }
+						};
+				};
+			};
+
+		template<typename Column, std::size_t Index, std::size_t Use>
+			using keyset_parameter_t = parameter_t<value_type_of<Column>, keyset_parameter_name_t<Index, Use>>;
+
+		template<typename Column, typename Parameter>
+			auto keyset_compare(Column column, Parameter parameter, const std::integral_constant<sort_type, sort_type::asc>&)
+			-> decltype(column > parameter)
+			{
+				return column > parameter;
+			}
+
+		template<typename Column, typename Parameter>
+			auto keyset_compare(Column column, Parameter parameter, const std::integral_constant<sort_type, sort_type::desc>&)
+			-> decltype(column < parameter)
+			{
+				return column < parameter;
+			}
+
+		// The rows following a row in the order of the sort orders:
+		//   (a > ?) OR ((a = ?) AND (b < ?))
+		// for ORDER BY a ASC, b DESC. Row values, i.e. (a, b) > (?, ?), cannot express mixed directions
+		// and are not supported by all databases.
+		template<std::size_t Index, typename... SortOrders>
+			struct keyset_seek;
+
+		template<std::size_t Index, typename Column, sort_type SortType>
+			struct keyset_seek<Index, sort_order_t<Column, SortType>>
+			{
+				static auto make()
+					-> decltype(keyset_compare(Column{}, keyset_parameter_t<Column, Index, 0>{}, std::integral_constant<sort_type, SortType>{}))
+					{
+						return keyset_compare(Column{}, keyset_parameter_t<Column, Index, 0>{}, std::integral_constant<sort_type, SortType>{});
+					}
+			};
+
+		template<std::size_t Index, typename Column, sort_type SortType, typename Next, typename... Rest>
+			struct keyset_seek<Index, sort_order_t<Column, SortType>, Next, Rest...>
+			{
+				static auto make()
+					-> decltype(keyset_seek<Index, sort_order_t<Column, SortType>>::make()
+							or (Column{} == keyset_parameter_t<Column, Index, 1>{} and keyset_seek<Index + 1, Next, Rest...>::make()))
+					{
+						return keyset_seek<Index, sort_order_t<Column, SortType>>::make()
+							or (Column{} == keyset_parameter_t<Column, Index, 1>{} and keyset_seek<Index + 1, Next, Rest...>::make());
+					}
+			};
+
+		template<typename OrderBy>
+			struct keyset_order_by
+			{
+				static_assert(wrong_t<keyset_order_by>::value, "keyset_pager() requires a statement with a static order_by()");
+			};
+
+		template<typename... Expressions, sort_type... SortTypes>
+			struct keyset_order_by<order_by_t<void, sort_order_t<Expressions, SortTypes>...>>
+			{
+				static_assert(logic::all_t<is_column_t<Expressions>::value...>::value, "keyset_pager() requires the order_by() expressions to be columns");
+				static_assert(not has_duplicates<Expressions...>::value, "at least one duplicate column in the order_by() of keyset_pager()");
+
+				using _columns = std::tuple<Expressions...>;
+				using _seek_t = decltype(keyset_seek<0, sort_order_t<Expressions, SortTypes>...>::make());
+			};
+
+		// Adds the seek predicate to the where condition of a statement
+		template<typename Where, typename Seek>
+			struct keyset_where
+			{
+				static_assert(wrong_t<keyset_where>::value, "keyset_pager() does not support dynamic_where()");
+			};
+
+		template<typename... Expressions, typename Seek>
+			struct keyset_where<where_t<void, Expressions...>, Seek>
+			{
+				using type = where_t<void, Expressions..., Seek>;
+
+				template<std::size_t... Is>
+					static where_data_t<void, Expressions..., Seek> _make(const where_data_t<void, Expressions...>& where, Seek seek, const index_sequence<Is...>&)
+					{
+						return {std::get<Is>(where._expressions)..., seek};
+					}
+
+				static where_data_t<void, Expressions..., Seek> make(const where_data_t<void, Expressions...>& where, Seek seek)
+				{
+					return _make(where, seek, make_index_sequence<sizeof...(Expressions)>{});
+				}
+			};
+
+		template<typename Seek>
+			struct keyset_where<where_t<void, bool>, Seek>
+			{
+				using type = where_t<void, Seek>;
+
+				// Pages after the first one follow a row, so the condition is true
+				static where_data_t<void, Seek> make(const where_data_t<void, bool>&, Seek seek)
+				{
+					return {seek};
+				}
+			};
+
+		template<bool WhereRequired, typename Seek>
+			struct keyset_where<no_where_t<WhereRequired>, Seek>
+			{
+				using type = where_t<void, Seek>;
+
+				static where_data_t<void, Seek> make(const no_data_t&, Seek seek)
+				{
+					return {seek};
+				}
+			};
+
+		template<typename Statement>
+			struct keyset_statement
+			{
+				static_assert(wrong_t<keyset_statement>::value, "keyset_pager() requires a select statement");
+			};
+
+		template<typename Database, typename... Policies>
+			struct keyset_statement<statement_t<Database, Policies...>>
+			{
+				using _policies_t = statement_policies_t<Database, Policies...>;
+				using _order_by_t = keyset_order_by<get_first_if<is_order_by_t, void, Policies...>>;
+				using _old_where_t = get_first_if<is_where_t, void, Policies...>;
+				using _where_t = keyset_where<_old_where_t, typename _order_by_t::_seek_t>;
+				using _seek_statement_t = typename _policies_t::template _new_statement_t<_old_where_t, typename _where_t::type>;
+
+				static_assert(logic::any_t<is_select_t<Policies>::value...>::value, "keyset_pager() requires a select statement");
+				static_assert(is_element_of<no_limit_t, make_type_set_t<Policies...>>::value, "keyset_pager() adds the limit(), the statement must not have one");
+				static_assert(is_element_of<no_offset_t, make_type_set_t<Policies...>>::value, "keyset_pager() replaces offset(), the statement must not have one");
+
+				static _seek_statement_t make(const statement_t<Database, Policies...>& statement)
+				{
+					const auto& where = static_cast<const typename _old_where_t::template _base_t<_policies_t>&>(statement)();
+					return {statement, _where_t::make(where._data, _make_seek(statement))};
+				}
+
+			private:
+				template<typename... SortOrders>
+					static auto _seek(const order_by_t<void, SortOrders...>*) -> decltype(keyset_seek<0, SortOrders...>::make())
+					{
+						return keyset_seek<0, SortOrders...>::make();
+					}
+
+				static typename _order_by_t::_seek_t _make_seek(const statement_t<Database, Policies...>&)
+				{
+					return _seek(static_cast<const get_first_if<is_order_by_t, void, Policies...>*>(nullptr));
+				}
+			};
+	}
+
+	// Pages through the result of a select with a static order_by() by seeking past the last row of the
+	// previous page instead of skipping rows with offset():
+	//   auto pager = keyset_pager(db, select(t.id, t.name).from(t).where(t.active).order_by(t.name.asc(), t.id.asc()), 100);
+	//   while (not pager.done())
+	//     for (const auto& row : pager.next())
+	//       ...
+	//
+	// Every page runs one of two prepared statements: the statement with limit(page_size) for the first
+	// page, and the statement with the seek predicate added to its where() for all following pages.
+	// The order_by() columns have to be selected and should be unique together, rows with the same
+	// keys as the last row of a page are skipped otherwise.
+	template<typename Db, typename Statement>
+		class keyset_pager_t
+		{
+			using _keyset_t = detail::keyset_statement<Statement>;
+			using _columns = typename _keyset_t::_order_by_t::_columns;
+			static constexpr std::size_t _no_of_keys = std::tuple_size<_columns>::value;
+
+			static_assert(detail::type_vector_size<parameters_of<Statement>>::value == 0, "keyset_pager() binds the seek parameters only, the statement must not contain parameters");
+
+			using _first_statement_t = decltype(std::declval<const Statement&>().limit(int64_t{}));
+			using _next_statement_t = decltype(std::declval<const typename _keyset_t::_seek_statement_t&>().limit(int64_t{}));
+			using _first_t = decltype(std::declval<Db&>().prepare(std::declval<const _first_statement_t&>()));
+			using _next_t = decltype(std::declval<Db&>().prepare(std::declval<const _next_statement_t&>()));
+			using _result_t = decltype(std::declval<Db&>()(std::declval<const _next_t&>()));
+
+			static_assert(std::is_same<_result_t, decltype(std::declval<Db&>()(std::declval<const _first_t&>()))>::value, "first and following pages have to yield the same result type");
+
+			template<std::size_t I>
+				using _column_t = typename std::tuple_element<I, _columns>::type;
+			template<std::size_t I>
+				using _field_spec_t = make_field_spec_t<_next_statement_t, _column_t<I>>;
+			template<std::size_t I>
+				using _field_t = member_t<_field_spec_t<I>, result_field_t<value_type_of<_field_spec_t<I>>, Db, _field_spec_t<I>>>;
+			template<std::size_t I>
+				using _cpp_value_t = typename value_type_of<_column_t<I>>::_cpp_value_type;
+			template<std::size_t I, std::size_t Use>
+				using _parameter_t = member_t<detail::keyset_parameter_name_t<I, Use>, parameter_value_t<value_type_of<_column_t<I>>>>;
+
+			template<typename IndexSequence>
+				struct _keys_impl;
+
+			template<std::size_t... Is>
+				struct _keys_impl<detail::index_sequence<Is...>>
+				{
+					using type = std::tuple<_cpp_value_t<Is>...>;
+				};
+
+		public:
+			using _row_t = typename std::decay<decltype(std::declval<_result_t&>().front())>::type;
+
+		private:
+			template<std::size_t... Is>
+				static void _check_selected(const detail::index_sequence<Is...>&)
+				{
+					static_assert(logic::all_t<std::is_base_of<_field_t<Is>, _row_t>::value...>::value, "keyset_pager() requires the order_by() columns to be selected");
+				}
+
+		public:
+			// A page of rows, like result_t. Visited rows are remembered by the pager to seek past them.
+			class page_t
+			{
+				using _result_iterator_t = decltype(std::declval<_result_t&>().begin());
+
+			public:
+				class iterator
+				{
+				public:
+					iterator(_result_iterator_t it, keyset_pager_t& pager):
+						_it(it),
+						_pager(pager)
+					{}
+
+					const _row_t& operator*() const
+					{
+						return *_it;
+					}
+
+					const _row_t* operator->() const
+					{
+						return &*_it;
+					}
+
+					bool operator==(const iterator& rhs) const
+					{
+						return _it == rhs._it;
+					}
+
+					bool operator!=(const iterator& rhs) const
+					{
+						return not (operator==(rhs));
+					}
+
+					void operator++()
+					{
+						_pager._visit(*_it);
+						++_it;
+					}
+
+				private:
+					_result_iterator_t _it;
+					keyset_pager_t& _pager;
+				};
+
+				page_t(_result_t&& result, keyset_pager_t& pager):
+					_result(std::move(result)),
+					_pager(&pager)
+				{}
+
+				page_t(const page_t&) = delete;
+				page_t(page_t&&) = default;
+				page_t& operator=(const page_t&) = delete;
+				page_t& operator=(page_t&&) = default;
+				~page_t() = default;
+
+				iterator begin()
+				{
+					return {_result.begin(), *_pager};
+				}
+
+				iterator end()
+				{
+					return {_result.end(), *_pager};
+				}
+
+				const _row_t& front() const
+				{
+					return _result.front();
+				}
+
+				bool empty() const
+				{
+					return _result.empty();
+				}
+
+				void pop_front()
+				{
+					_pager->_visit(_result.front());
+					_result.pop_front();
+				}
+
+			private:
+				_result_t _result;
+				keyset_pager_t* _pager;
+			};
+
+			keyset_pager_t(Db& db, const Statement& statement, std::size_t page_size):
+				_db(db),
+				_page_size(_checked_page_size(page_size)),
+				_first(db.prepare(statement.limit(static_cast<int64_t>(_page_size)))),
+				_next(db.prepare(_keyset_t::make(statement).limit(static_cast<int64_t>(_page_size))))
+			{
+				_check_selected(detail::make_index_sequence<_no_of_keys>{});
+			}
+
+			keyset_pager_t(const keyset_pager_t&) = delete;
+			keyset_pager_t(keyset_pager_t&&) = default;
+			keyset_pager_t& operator=(const keyset_pager_t&) = delete;
+			keyset_pager_t& operator=(keyset_pager_t&&) = delete;
+			~keyset_pager_t() = default;
+
+			// True once a page had fewer rows than the page size, rows of a page have to be visited to be counted
+			bool done() const
+			{
+				return _started and _visited < _page_size;
+			}
+
+			// Runs the first page or the page after the last visited row
+			page_t next()
+			{
+				if (not _started)
+				{
+					_started = true;
+					_visited = 0;
+					return {_db(_first), *this};
+				}
+				_bind_keys(detail::make_index_sequence<_no_of_keys>{});
+				_visited = 0;
+				return {_db(_next), *this};
+			}
+
+			// Runs the page after the given row, e.g. the last row of a page shown to a user earlier
+			page_t after(const _row_t& row)
+			{
+				_remember(row, detail::make_index_sequence<_no_of_keys>{});
+				_started = true;
+				return next();
+			}
+
+		private:
+			void _visit(const _row_t& row)
+			{
+				_remember(row, detail::make_index_sequence<_no_of_keys>{});
+				++_visited;
+			}
+
+			template<std::size_t... Is>
+				void _remember(const _row_t& row, const detail::index_sequence<Is...>&)
+				{
+					using swallow = int[];  // see interpret_tuple.h
+					(void) swallow{0, (_remember_key<Is>(static_cast<const _field_t<Is>&>(row)()), 0)...};
+				}
+
+			template<std::size_t I, typename Field>
+				void _remember_key(const Field& field)
+				{
+					if (field.is_null())
+						throw exception("keyset_pager() cannot seek past NULL keys");
+					std::get<I>(_keys) = field.value();
+				}
+
+			template<std::size_t... Is>
+				void _bind_keys(const detail::index_sequence<Is...>&)
+				{
+					using swallow = int[];  // see interpret_tuple.h
+					(void) swallow{0, (_bind_key<Is>(std::integral_constant<bool, Is + 1 < _no_of_keys>{}), 0)...};
+				}
+
+			template<std::size_t I>
+				void _bind_key(const std::true_type&)
+				{
+					_bind_key<I>(std::false_type{});
+					static_cast<_parameter_t<I, 1>&>(_next.params)() = std::get<I>(_keys);
+				}
+
+			template<std::size_t I>
+				void _bind_key(const std::false_type&)
+				{
+					static_cast<_parameter_t<I, 0>&>(_next.params)() = std::get<I>(_keys);
+				}
+
+			// Called before anything is prepared
+			static std::size_t _checked_page_size(std::size_t page_size)
+			{
+				if (page_size == 0)
+					throw exception("keyset_pager() requires a page size greater than zero");
+				return page_size;
+			}
+
+			Db& _db;
+			std::size_t _page_size;
+			_first_t _first;
+			_next_t _next;
+			typename _keys_impl<detail::make_index_sequence<_no_of_keys>>::type _keys;
+			bool _started = false;
+			std::size_t _visited = 0;
+		};
+
+	template<typename Db, typename Statement>
+		keyset_pager_t<Db, Statement> keyset_pager(Db& db, const Statement& statement, std::size_t page_size)
+		{
+			return {db, statement, page_size};
+		}
+}
+
+#endif
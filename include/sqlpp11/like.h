@@ -30,6 +30,7 @@
 #include <sqlpp11/boolean.h>
 #include <sqlpp11/type_traits.h>
 #include <sqlpp11/char_sequence.h>
+#include <sqlpp11/static_sql.h>
 #include <sqlpp11/detail/type_set.h>
 
 namespace sqlpp
@@ -85,6 +86,14 @@ namespace sqlpp
 				return context;
 			}
 		};
+
+	template<typename Operand, typename Pattern>
+		struct static_sql_t<like_t<Operand, Pattern>>
+		{
+			static constexpr const char _literal[] = " LIKE(";
+			using type = static_sql_cat_t<static_sql_operand_of<Operand>, make_static_sql_literal<sizeof(_literal), _literal>,
+						static_sql_of<Pattern>, char_sequence<')'>>;
+		};
 }
 
 #endif
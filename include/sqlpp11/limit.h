@@ -29,6 +29,7 @@
 
 #include <sqlpp11/type_traits.h>
 #include <sqlpp11/policy_update.h>
+#include <sqlpp11/static_sql.h>
 #include <sqlpp11/detail/type_set.h>
 
 namespace sqlpp
@@ -261,6 +262,13 @@ namespace sqlpp
 				return context;
 			}
 		};
+
+	template<typename Limit>
+		struct static_sql_t<limit_data_t<Limit>>
+		{
+			static constexpr const char _literal[] = " LIMIT ";
+			using type = static_sql_cat_t<make_static_sql_literal<sizeof(_literal), _literal>, static_sql_operand_of<Limit>>;
+		};
 }
 
 #endif
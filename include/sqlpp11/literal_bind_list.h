@@ -0,0 +1,150 @@
+/*
+ * literal_bind_list.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_LITERAL_BIND_LIST_H
+#define SQLPP_LITERAL_BIND_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+namespace sqlpp
+{
+	// Values of wrapped operands (see wrap_operand.h) that have been replaced by
+	// placeholders during serialization, in placeholder order.
+	//
+	// Bound via the same _bind_*_parameter interface as parameter_list_t, so a
+	// connector can prepare the literal free text once and bind the values to it.
+	struct literal_bind_list_t
+	{
+		enum class type_t
+		{
+			boolean,
+			integral,
+			floating_point,
+			text
+		};
+
+		struct entry_t
+		{
+			type_t _type;
+			signed char _boolean;
+			int64_t _integral;
+			double _floating_point;
+			std::string _text;
+		};
+
+		std::size_t size() const
+		{
+			return _entries.size();
+		}
+
+		bool empty() const
+		{
+			return _entries.empty();
+		}
+
+		const entry_t& operator[](std::size_t index) const
+		{
+			return _entries[index];
+		}
+
+		void clear()
+		{
+			_entries.clear();
+		}
+
+		void _add(bool value)
+		{
+			_entries.push_back({type_t::boolean, static_cast<signed char>(value), 0, 0.0, {}});
+		}
+
+		void _add(int64_t value)
+		{
+			_entries.push_back({type_t::integral, 0, value, 0.0, {}});
+		}
+
+		void _add(double value)
+		{
+			_entries.push_back({type_t::floating_point, 0, 0, value, {}});
+		}
+
+		void _add(const std::string& value)
+		{
+			_entries.push_back({type_t::text, 0, 0, 0.0, value});
+		}
+
+		template<typename Target>
+			void _bind(Target& target) const
+			{
+				for (std::size_t index = 0; index < _entries.size(); ++index)
+					_bind_entry(target, index, _entries[index], false);
+			}
+
+		template<typename Target>
+			static void _bind_entry(Target& target, std::size_t index, const entry_t& entry, bool is_null)
+			{
+				switch (entry._type)
+				{
+				case type_t::boolean:
+					target._bind_boolean_parameter(index, &entry._boolean, is_null);
+					break;
+				case type_t::integral:
+					target._bind_integral_parameter(index, &entry._integral, is_null);
+					break;
+				case type_t::floating_point:
+					target._bind_floating_point_parameter(index, &entry._floating_point, is_null);
+					break;
+				case type_t::text:
+					target._bind_text_parameter(index, &entry._text, is_null);
+					break;
+				}
+			}
+
+	private:
+		std::vector<entry_t> _entries;
+	};
+
+	// Contexts opt in to literal parameterization by providing
+	//   using _parameterize_literals = std::true_type;
+	//   ::sqlpp::literal_bind_list_t _literals;
+	//   bool _inline_literals;
+	// Wrapped operands are then serialized as '?' and their values appended to _literals,
+	// unless _inline_literals is set.
+	template<typename Context, typename Enable = void>
+		struct parameterizes_literals_t: std::false_type
+		{};
+
+	template<typename Context>
+		struct parameterizes_literals_t<Context, typename std::enable_if<Context::_parameterize_literals::value, void>::type>: std::true_type
+		{};
+}
+
+#endif
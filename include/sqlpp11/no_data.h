@@ -29,6 +29,7 @@
 
 #include <type_traits>
 #include <sqlpp11/serializer.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
@@ -45,5 +46,11 @@ namespace sqlpp
 				return context;
 			}
 		};
+
+	template<>
+		struct static_sql_t<no_data_t>
+		{
+			using type = char_sequence<>;
+		};
 }
 #endif
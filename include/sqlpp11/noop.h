@@ -69,14 +69,14 @@ namespace sqlpp
 					auto _prepare(Db& db, const Composite& composite) const
 					-> prepared_execute_t<Db, Composite>
 					{
-						return {{}, db.prepare_execute(composite)};
+						return {{}, {}, db.prepare_execute(composite)};
 					}
 
 				template<typename Db>
 					auto _prepare(Db& db) const
 					-> prepared_execute_t<Db, _statement_t>
 					{
-						return {{}, db.prepare_execute(_get_statement())};
+						return {{}, _get_statement()._get_dynamic_parameters(), db.prepare_execute(_get_statement())};
 					}
 			};
 	};
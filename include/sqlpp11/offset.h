@@ -29,6 +29,7 @@
 
 #include <sqlpp11/type_traits.h>
 #include <sqlpp11/policy_update.h>
+#include <sqlpp11/static_sql.h>
 #include <sqlpp11/detail/type_set.h>
 
 namespace sqlpp
@@ -260,6 +261,13 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Offset>
+		struct static_sql_t<offset_data_t<Offset>>
+		{
+			static constexpr const char _literal[] = " OFFSET ";
+			using type = static_sql_cat_t<make_static_sql_literal<sizeof(_literal), _literal>, static_sql_operand_of<Offset>>;
+		};
+
 	template<typename Context, typename Database>
 		struct serializer_t<Context, dynamic_offset_data_t<Database>>
 		{
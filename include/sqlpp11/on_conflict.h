@@ -0,0 +1,430 @@
+/*
+ * on_conflict.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_ON_CONFLICT_H
+#define SQLPP_ON_CONFLICT_H
+
+#include <sqlpp11/type_traits.h>
+#include <sqlpp11/logic.h>
+#include <sqlpp11/assignment.h>
+#include <sqlpp11/value_type_fwd.h>
+#include <sqlpp11/interpret_tuple.h>
+#include <sqlpp11/simple_column.h>
+#include <sqlpp11/no_data.h>
+#include <sqlpp11/policy_update.h>
+#include <sqlpp11/detail/type_set.h>
+
+namespace sqlpp
+{
+	// The value a conflicting insert tried to write into a column, usable in on_conflict(...).do_update(...), e.g.
+	//   insert_into(t).set(t.id = 7, t.hits = 1).on_conflict(t.id).do_update(t.hits = t.hits + excluded(t.hits))
+	template<typename Column>
+		struct excluded_t:
+			public expression_operators<excluded_t<Column>, value_type_of<Column>>
+	{
+		using _traits = make_traits<value_type_of<Column>, tag::is_expression>;
+		using _nodes = detail::type_vector<>;
+		using _required_tables = detail::type_set<typename Column::_table>;
+		using _can_be_null = can_be_null_t<Column>;
+
+		excluded_t() = default;
+		excluded_t(const excluded_t&) = default;
+		excluded_t(excluded_t&&) = default;
+		excluded_t& operator=(const excluded_t&) = default;
+		excluded_t& operator=(excluded_t&&) = default;
+		~excluded_t() = default;
+	};
+
+	template<typename Context, typename Column>
+		struct serializer_t<Context, excluded_t<Column>>
+		{
+			using _serialize_check = consistent_t;
+			using T = excluded_t<Column>;
+
+			static Context& _(const T& , Context& context)
+			{
+				context << "excluded." << name_of<Column>::char_ptr();
+				return context;
+			}
+		};
+
+	template<typename Column>
+		auto excluded(const Column&)
+		-> excluded_t<Column>
+		{
+			static_assert(is_column_t<Column>::value, "excluded() requires a column argument");
+			return {};
+		}
+
+	// CONFLICT TARGET DATA
+	template<typename... Columns>
+		struct on_conflict_data_t
+		{
+			using _traits = make_traits<no_value_t, tag::is_noop>;
+			using _nodes = detail::type_vector<Columns...>;
+
+			on_conflict_data_t(Columns... cols):
+				_columns(simple_column_t<Columns>{cols}...)
+			{}
+
+			on_conflict_data_t(const on_conflict_data_t&) = default;
+			on_conflict_data_t(on_conflict_data_t&&) = default;
+			on_conflict_data_t& operator=(const on_conflict_data_t&) = default;
+			on_conflict_data_t& operator=(on_conflict_data_t&&) = default;
+			~on_conflict_data_t() = default;
+
+			std::tuple<simple_column_t<Columns>...> _columns;
+		};
+
+	template<typename Context, typename... Columns>
+		struct serializer_t<Context, on_conflict_data_t<Columns...>>
+		{
+			using _serialize_check = serialize_check_of<Context, Columns...>;
+			using T = on_conflict_data_t<Columns...>;
+
+			static Context& _(const T& t, Context& context)
+			{
+				context << " ON CONFLICT";
+				if (sizeof...(Columns))
+				{
+					context << " (";
+					interpret_tuple(t._columns, ',', context);
+					context << ')';
+				}
+				return context;
+			}
+		};
+
+	struct assert_no_unknown_tables_in_on_conflict_t
+	{
+		using type = std::false_type;
+
+		template<typename T = void>
+		static void _()
+		{
+			static_assert(wrong_t<T>::value, "on_conflict() columns and assignments have to refer to the table inserted into");
+		}
+	};
+
+	template<typename Policies, typename Clause>
+		using on_conflict_table_check_t = typename std::conditional<Policies::template _no_unknown_tables<Clause>::value,
+					consistent_t,
+					assert_no_unknown_tables_in_on_conflict_t>::type;
+
+	// DO NOTHING DATA
+	template<typename Target>
+		struct on_conflict_do_nothing_data_t
+		{
+			on_conflict_do_nothing_data_t(Target target):
+				_target(target)
+			{}
+
+			on_conflict_do_nothing_data_t(const on_conflict_do_nothing_data_t&) = default;
+			on_conflict_do_nothing_data_t(on_conflict_do_nothing_data_t&&) = default;
+			on_conflict_do_nothing_data_t& operator=(const on_conflict_do_nothing_data_t&) = default;
+			on_conflict_do_nothing_data_t& operator=(on_conflict_do_nothing_data_t&&) = default;
+			~on_conflict_do_nothing_data_t() = default;
+
+			Target _target;
+		};
+
+	// ON CONFLICT ... DO NOTHING
+	template<typename Target>
+		struct on_conflict_do_nothing_t
+		{
+			using _traits = make_traits<no_value_t, tag::is_on_conflict>;
+			using _nodes = detail::type_vector<Target>;
+
+			// Data
+			using _data_t = on_conflict_do_nothing_data_t<Target>;
+
+			// Member implementation with data and methods
+			template<typename Policies>
+				struct _impl_t
+				{
+					_data_t _data;
+				};
+
+			// Base template to be inherited by the statement
+			template<typename Policies>
+				struct _base_t
+				{
+					using _data_t = on_conflict_do_nothing_data_t<Target>;
+
+					_impl_t<Policies> on_conflict;
+					_impl_t<Policies>& operator()() { return on_conflict; }
+					const _impl_t<Policies>& operator()() const { return on_conflict; }
+
+					template<typename T>
+						static auto _get_member(T t) -> decltype(t.on_conflict)
+						{
+							return t.on_conflict;
+						}
+
+					using _consistency_check = on_conflict_table_check_t<Policies, on_conflict_do_nothing_t>;
+				};
+		};
+
+	template<typename Context, typename Target>
+		struct serializer_t<Context, on_conflict_do_nothing_data_t<Target>>
+		{
+			using _serialize_check = serialize_check_of<Context, Target>;
+			using T = on_conflict_do_nothing_data_t<Target>;
+
+			static Context& _(const T& t, Context& context)
+			{
+				serialize(t._target, context);
+				context << " DO NOTHING";
+				return context;
+			}
+		};
+
+	// DO UPDATE DATA
+	template<typename Target, typename... Assignments>
+		struct on_conflict_do_update_data_t
+		{
+			on_conflict_do_update_data_t(Target target, Assignments... assignments):
+				_target(target),
+				_assignments(assignments...)
+			{}
+
+			on_conflict_do_update_data_t(const on_conflict_do_update_data_t&) = default;
+			on_conflict_do_update_data_t(on_conflict_do_update_data_t&&) = default;
+			on_conflict_do_update_data_t& operator=(const on_conflict_do_update_data_t&) = default;
+			on_conflict_do_update_data_t& operator=(on_conflict_do_update_data_t&&) = default;
+			~on_conflict_do_update_data_t() = default;
+
+			Target _target;
+			std::tuple<Assignments...> _assignments;
+		};
+
+	// ON CONFLICT ... DO UPDATE SET ...
+	template<typename Target, typename... Assignments>
+		struct on_conflict_do_update_t
+		{
+			using _traits = make_traits<no_value_t, tag::is_on_conflict>;
+			using _nodes = detail::type_vector<Target, Assignments...>;
+
+			// Data
+			using _data_t = on_conflict_do_update_data_t<Target, Assignments...>;
+
+			// Member implementation with data and methods
+			template<typename Policies>
+				struct _impl_t
+				{
+					_data_t _data;
+				};
+
+			// Base template to be inherited by the statement
+			template<typename Policies>
+				struct _base_t
+				{
+					using _data_t = on_conflict_do_update_data_t<Target, Assignments...>;
+
+					_impl_t<Policies> on_conflict;
+					_impl_t<Policies>& operator()() { return on_conflict; }
+					const _impl_t<Policies>& operator()() const { return on_conflict; }
+
+					template<typename T>
+						static auto _get_member(T t) -> decltype(t.on_conflict)
+						{
+							return t.on_conflict;
+						}
+
+					using _consistency_check = on_conflict_table_check_t<Policies, on_conflict_do_update_t>;
+				};
+		};
+
+	template<typename Context, typename Target, typename... Assignments>
+		struct serializer_t<Context, on_conflict_do_update_data_t<Target, Assignments...>>
+		{
+			using _serialize_check = serialize_check_of<Context, Target, Assignments...>;
+			using T = on_conflict_do_update_data_t<Target, Assignments...>;
+
+			static Context& _(const T& t, Context& context)
+			{
+				serialize(t._target, context);
+				context << " DO UPDATE SET ";
+				interpret_tuple(t._assignments, ",", context);
+				return context;
+			}
+		};
+
+	struct assert_on_conflict_action_t
+	{
+		using type = std::false_type;
+
+		template<typename T = void>
+			static void _()
+			{
+				static_assert(wrong_t<T>::value, "on_conflict() requires an action, i.e. do_nothing() or do_update(...)");
+			}
+	};
+
+	// ON CONFLICT (...) WITHOUT AN ACTION YET
+	template<typename... Columns>
+		struct on_conflict_t
+		{
+			using _traits = make_traits<no_value_t, tag::is_on_conflict>;
+			using _nodes = detail::type_vector<Columns...>;
+
+			// Data
+			using _data_t = on_conflict_data_t<Columns...>;
+
+			// Member implementation with data and methods
+			template<typename Policies>
+				struct _impl_t
+				{
+					_data_t _data;
+				};
+
+			// Base template to be inherited by the statement
+			template<typename Policies>
+				struct _base_t
+				{
+					using _data_t = on_conflict_data_t<Columns...>;
+
+					_impl_t<Policies> on_conflict;
+					_impl_t<Policies>& operator()() { return on_conflict; }
+					const _impl_t<Policies>& operator()() const { return on_conflict; }
+
+					template<typename T>
+						static auto _get_member(T t) -> decltype(t.on_conflict)
+						{
+							return t.on_conflict;
+						}
+
+					template<typename... T>
+						using _check = logic::all_t<is_assignment_t<T>::value...>;
+
+					template<typename Check, typename T>
+						using _new_statement_t = new_statement_t<Check::value, Policies, on_conflict_t, T>;
+
+					using _consistency_check = assert_on_conflict_action_t;
+
+					auto do_nothing() const
+						-> _new_statement_t<std::true_type, on_conflict_do_nothing_t<_data_t>>
+						{
+							return { static_cast<const derived_statement_t<Policies>&>(*this), on_conflict_do_nothing_data_t<_data_t>{on_conflict._data} };
+						}
+
+					template<typename... Assignments>
+						auto do_update(Assignments... assignments) const
+						-> _new_statement_t<_check<Assignments...>, on_conflict_do_update_t<_data_t, Assignments...>>
+						{
+							static_assert(sizeof...(Columns), "do_update() requires conflict target columns, e.g. on_conflict(t.id)");
+							static_assert(sizeof...(Assignments), "at least one assignment expression required in do_update()");
+							static_assert(_check<Assignments...>::value, "at least one argument is not an assignment in do_update()");
+							static_assert(not detail::has_duplicates<lhs_t<Assignments>...>::value, "at least one duplicate column detected in do_update()");
+							static_assert(logic::none_t<must_not_update_t<lhs_t<Assignments>>::value...>::value, "at least one assignment in do_update() is prohibited by its column definition");
+
+							return _do_update_impl(_check<Assignments...>{}, assignments...);
+						}
+
+				private:
+					template<typename... Assignments>
+						auto _do_update_impl(const std::false_type&, Assignments... assignments) const
+						-> bad_statement;
+
+					template<typename... Assignments>
+						auto _do_update_impl(const std::true_type&, Assignments... assignments) const
+						-> _new_statement_t<std::true_type, on_conflict_do_update_t<_data_t, Assignments...>>
+						{
+							return { static_cast<const derived_statement_t<Policies>&>(*this), on_conflict_do_update_data_t<_data_t, Assignments...>{on_conflict._data, assignments...} };
+						}
+				};
+		};
+
+	// NO ON CONFLICT YET
+	struct no_on_conflict_t
+	{
+		using _traits = make_traits<no_value_t, tag::is_noop>;
+		using _nodes = detail::type_vector<>;
+
+		// Data
+		using _data_t = no_data_t;
+
+		// Member implementation with data and methods
+		template<typename Policies>
+			struct _impl_t
+			{
+				_data_t _data;
+			};
+
+		// Base template to be inherited by the statement
+		template<typename Policies>
+			struct _base_t
+			{
+				using _data_t = no_data_t;
+
+				_impl_t<Policies> no_on_conflict;
+				_impl_t<Policies>& operator()() { return no_on_conflict; }
+				const _impl_t<Policies>& operator()() const { return no_on_conflict; }
+
+				template<typename T>
+					static auto _get_member(T t) -> decltype(t.no_on_conflict)
+					{
+						return t.no_on_conflict;
+					}
+
+				template<typename... T>
+					using _check = logic::all_t<is_column_t<T>::value...>;
+
+				template<typename Check, typename T>
+					using _new_statement_t = new_statement_t<Check::value, Policies, no_on_conflict_t, T>;
+
+				using _consistency_check = consistent_t;
+
+				// Without columns, the conflict target is left to the database (not supported by all of them for do_update)
+				template<typename... Columns>
+					auto on_conflict(Columns... columns) const
+					-> _new_statement_t<_check<Columns...>, on_conflict_t<Columns...>>
+					{
+						static_assert(_check<Columns...>::value, "at least one argument is not a column in on_conflict()");
+						static_assert(not detail::has_duplicates<Columns...>::value, "at least one duplicate argument detected in on_conflict()");
+
+						return _on_conflict_impl(_check<Columns...>{}, columns...);
+					}
+
+			private:
+				template<typename... Columns>
+					auto _on_conflict_impl(const std::false_type&, Columns... columns) const
+					-> bad_statement;
+
+				template<typename... Columns>
+					auto _on_conflict_impl(const std::true_type&, Columns... columns) const
+					-> _new_statement_t<std::true_type, on_conflict_t<Columns...>>
+					{
+						return { static_cast<const derived_statement_t<Policies>&>(*this), on_conflict_data_t<Columns...>{columns...} };
+					}
+			};
+	};
+
+}
+
+#endif
@@ -29,6 +29,7 @@
 
 #include <sqlpp11/type_traits.h>
 #include <sqlpp11/alias_provider.h>
+#include <sqlpp11/static_sql.h>
 #include <sqlpp11/detail/type_set.h>
 
 namespace sqlpp
@@ -68,6 +69,12 @@ namespace sqlpp
 			}
 		};
 
+	template<typename ValueType, typename NameType>
+		struct static_sql_t<parameter_t<ValueType, NameType>>
+		{
+			using type = char_sequence<'?'>;
+		};
+
 	template<typename NamedExpr>
 		auto parameter(const NamedExpr&)
 		-> parameter_t<value_type_of<NamedExpr>, NamedExpr>
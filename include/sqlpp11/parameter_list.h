@@ -55,12 +55,56 @@ namespace sqlpp
 					_bind_impl(target, detail::make_index_sequence<size::value>{});
 				}
 
+			// Binds count parameter lists at once, starting with this one.
+			// The values of each parameter are stride bytes apart, e.g. sizeof(parameter_list_t) for
+			// a contiguous array. Targets use this for native array binding (row-wise), see
+			// connector_api/prepared_statement.h
+			template<typename Target>
+				void _bind_array(Target& target, size_t stride, size_t count) const
+				{
+					_bind_array_impl(target, stride, count, detail::make_index_sequence<size::value>{});
+				}
+
+			// Same as above, but binds the parameter with index i at positions[i], see dynamic_parameter_list.h
+			template<typename Target>
+				void _bind(Target& target, const size_t* positions) const
+				{
+					_bind_impl(target, positions, detail::make_index_sequence<size::value>{});
+				}
+
+			template<typename Target>
+				void _bind_array(Target& target, const size_t* positions, size_t stride, size_t count) const
+				{
+					_bind_array_impl(target, positions, stride, count, detail::make_index_sequence<size::value>{});
+				}
+
 		private:
 			template<typename Target, size_t... Is>
 				void _bind_impl(Target& target, const detail::index_sequence<Is...>&) const
 				{
 					using swallow = int[];  // see interpret_tuple.h
-					(void) swallow{(static_cast<typename std::tuple_element<Is, const _member_tuple_t>::type&>(*this)()._bind(target, Is), 0)...};
+					(void) swallow{0, (static_cast<typename std::tuple_element<Is, const _member_tuple_t>::type&>(*this)()._bind(target, Is), 0)...};
+				}
+
+			template<typename Target, size_t... Is>
+				void _bind_array_impl(Target& target, size_t stride, size_t count, const detail::index_sequence<Is...>&) const
+				{
+					using swallow = int[];  // see interpret_tuple.h
+					(void) swallow{0, (static_cast<typename std::tuple_element<Is, const _member_tuple_t>::type&>(*this)()._bind_array(target, Is, stride, count), 0)...};
+				}
+
+			template<typename Target, size_t... Is>
+				void _bind_impl(Target& target, const size_t* positions, const detail::index_sequence<Is...>&) const
+				{
+					using swallow = int[];  // see interpret_tuple.h
+					(void) swallow{0, (static_cast<typename std::tuple_element<Is, const _member_tuple_t>::type&>(*this)()._bind(target, positions[Is]), 0)...};
+				}
+
+			template<typename Target, size_t... Is>
+				void _bind_array_impl(Target& target, const size_t* positions, size_t stride, size_t count, const detail::index_sequence<Is...>&) const
+				{
+					using swallow = int[];  // see interpret_tuple.h
+					(void) swallow{0, (static_cast<typename std::tuple_element<Is, const _member_tuple_t>::type&>(*this)()._bind_array(target, positions[Is], stride, count), 0)...};
 				}
 		};
 
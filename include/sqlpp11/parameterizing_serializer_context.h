@@ -0,0 +1,66 @@
+/*
+ * parameterizing_serializer_context.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_PARAMETERIZING_SERIALIZER_CONTEXT_H
+#define SQLPP_PARAMETERIZING_SERIALIZER_CONTEXT_H
+
+#include <type_traits>
+#include <sqlpp11/buffer_serializer_context.h>
+#include <sqlpp11/literal_bind_list.h>
+
+namespace sqlpp
+{
+	// Serializer context that replaces wrapped operands by placeholders.
+	//
+	// `t.id == 42` and `t.id == 43` both yield "(tab.id=?)", with 42 or 43 in
+	// _literals. Connectors can use str() as the key of a prepared statement
+	// cache and bind _literals to the cached statement. Dynamic statement parts
+	// are serialized with the connection's own context, so connectors derive
+	// their _serializer_context_t from this one.
+	//
+	// This is meant for directly executed statements. Parameters of prepared
+	// statements are indexed independently of the literals, and nothing binds
+	// _literals when a prepared statement is executed. Connectors therefore
+	// set _inline_literals in the contexts they serialize for prepare(), which
+	// then yield "(tab.id=42)" as usual.
+	struct parameterizing_serializer_context_t: public buffer_serializer_context_t
+	{
+		using _parameterize_literals = std::true_type;
+
+		void reset()
+		{
+			buffer_serializer_context_t::reset();
+			_literals.clear();
+		}
+
+		literal_bind_list_t _literals;
+		bool _inline_literals = false;
+	};
+}
+
+#endif
@@ -27,7 +27,9 @@
 #ifndef SQLPP_PREPARED_INSERT_H
 #define SQLPP_PREPARED_INSERT_H
 
+#include <vector>
 #include <sqlpp11/parameter_list.h>
+#include <sqlpp11/dynamic_parameter_list.h>
 #include <sqlpp11/result.h>
 #include <sqlpp11/no_value.h>
 
@@ -52,10 +54,25 @@ namespace sqlpp
 
 			void _bind_params() const
 			{
-				params._bind(_prepared_statement);
+				dynamic_params._bind(params, _prepared_statement);
+			}
+
+			// For db.run_batch(prepared, rows): rows is a contiguous range of _parameter_list_t
+			using _batch_t = std::vector<_parameter_list_t>;
+
+			void _bind_params(const _parameter_list_t& row) const
+			{
+				dynamic_params._bind(row, _prepared_statement);
+			}
+
+			void _bind_batch(const _parameter_list_t* rows, size_t count) const
+			{
+				if (count)
+					dynamic_params._bind_array(*rows, _prepared_statement, sizeof(_parameter_list_t), count);
 			}
 
 			_parameter_list_t params;
+			dynamic_parameter_list_t dynamic_params;
 			mutable _prepared_statement_t _prepared_statement;
 		};
 
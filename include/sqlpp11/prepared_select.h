@@ -27,7 +27,9 @@
 #ifndef SQLPP_PREPARED_SELECT_H
 #define SQLPP_PREPARED_SELECT_H
 
+#include <sqlpp11/wrong.h>
 #include <sqlpp11/parameter_list.h>
+#include <sqlpp11/dynamic_parameter_list.h>
 #include <sqlpp11/result.h>
 #include <sqlpp11/no_value.h>
 
@@ -54,11 +56,19 @@ namespace sqlpp
 
 			void _bind_params() const
 			{
-				params._bind(_prepared_statement);
+				dynamic_params._bind(params, _prepared_statement);
 			}
 
+			// run_batch() returns a count, the result rows would be lost
+			template<typename T = void>
+				void _bind_batch(const _parameter_list_t*, size_t) const
+				{
+					static_assert(wrong_t<T>::value, "run_batch() cannot return result rows, run selects and statements with returning() one at a time");
+				}
+
 			_parameter_list_t params;
 			_dynamic_names_t _dynamic_names;
+			dynamic_parameter_list_t dynamic_params;
 			mutable _prepared_statement_t _prepared_statement;
 		};
 
@@ -0,0 +1,193 @@
+/*
+ * prepared_statement_cache.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_PREPARED_STATEMENT_CACHE_H
+#define SQLPP_PREPARED_STATEMENT_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <sqlpp11/serialize.h>
+#include <sqlpp11/statement_shape.h>
+
+namespace sqlpp
+{
+	// Per-connection cache of prepared statements with LRU eviction.
+	//
+	// Entries are keyed by the shape of the statement (see statement_shape.h).
+	// If the shape does not determine the SQL text, e.g. because of literal
+	// values, the serialized text is part of the key, too. Otherwise, e.g. for
+	// statements with compile-time SQL text or dynamic parts without literals,
+	// nothing is serialized for the lookup.
+	//
+	// Prepared statements are handed out as shared_ptr, so evicting an entry
+	// does not invalidate a statement that is still in use. The cache is not
+	// thread safe, just like the connection it belongs to.
+	template<typename Db>
+		class prepared_statement_cache_t
+		{
+			struct _key_t
+			{
+				statement_shape_t _shape;
+				std::string _text;
+
+				bool operator==(const _key_t& rhs) const
+				{
+					return _shape == rhs._shape and _text == rhs._text;
+				}
+			};
+
+			struct _key_hash_t
+			{
+				std::size_t operator()(const _key_t& key) const
+				{
+					const auto seed = key._shape.hash();
+					return seed ^ (std::hash<std::string>{}(key._text) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+				}
+			};
+
+			using _entry_t = std::pair<_key_t, std::shared_ptr<void>>;
+			using _lru_list_t = std::list<_entry_t>;
+
+		public:
+			prepared_statement_cache_t():
+				_max_size(64)
+			{}
+
+			explicit prepared_statement_cache_t(std::size_t max_size):
+				_max_size(max_size)
+			{}
+
+			prepared_statement_cache_t(const prepared_statement_cache_t&) = delete;
+			prepared_statement_cache_t(prepared_statement_cache_t&&) = default;
+			prepared_statement_cache_t& operator=(const prepared_statement_cache_t&) = delete;
+			prepared_statement_cache_t& operator=(prepared_statement_cache_t&&) = default;
+			~prepared_statement_cache_t() = default;
+
+			// Returns the cached prepared statement for the statement, preparing it on a miss
+			template<typename Database, typename Statement>
+				auto get(Database& db, const Statement& statement)
+				-> std::shared_ptr<decltype(db.prepare(statement))>
+				{
+					static_assert(std::is_same<Database, Db>::value, "statement cache used with the wrong connection type");
+					using _prepared_t = decltype(db.prepare(statement));
+
+					auto shape = shape_of(statement);
+					auto text = shape.determines_sql() ? std::string{} : _text(db, statement);
+					auto key = _key_t{std::move(shape), std::move(text)};
+
+					const auto it = _index.find(key);
+					if (it != _index.end())
+					{
+						++_hits;
+						_lru.splice(_lru.begin(), _lru, it->second);
+						return std::static_pointer_cast<_prepared_t>(it->second->second);
+					}
+
+					++_misses;
+					auto prepared = std::make_shared<_prepared_t>(db.prepare(statement));
+					if (_max_size == 0)
+						return prepared;
+
+					_lru.emplace_front(std::move(key), prepared);
+					_index.emplace(_lru.front().first, _lru.begin());
+					_shrink_to(_max_size);
+					return prepared;
+				}
+
+			std::size_t size() const
+			{
+				return _lru.size();
+			}
+
+			std::size_t max_size() const
+			{
+				return _max_size;
+			}
+
+			void set_max_size(std::size_t max_size)
+			{
+				_max_size = max_size;
+				_shrink_to(_max_size);
+			}
+
+			void clear()
+			{
+				_index.clear();
+				_lru.clear();
+			}
+
+			std::size_t hits() const
+			{
+				return _hits;
+			}
+
+			std::size_t misses() const
+			{
+				return _misses;
+			}
+
+			std::size_t evictions() const
+			{
+				return _evictions;
+			}
+
+		private:
+			template<typename Statement>
+				static std::string _text(Db& db, const Statement& statement)
+				{
+					auto context = db.get_serializer_context();
+					serialize(statement, context);
+					return context.str();
+				}
+
+			void _shrink_to(std::size_t max_size)
+			{
+				while (_lru.size() > max_size)
+				{
+					_index.erase(_lru.back().first);
+					_lru.pop_back();
+					++_evictions;
+				}
+			}
+
+			std::size_t _max_size;
+			_lru_list_t _lru;
+			std::unordered_map<_key_t, typename _lru_list_t::iterator, _key_hash_t> _index;
+			std::size_t _hits = 0;
+			std::size_t _misses = 0;
+			std::size_t _evictions = 0;
+		};
+}
+
+#endif
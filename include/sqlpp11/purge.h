@@ -0,0 +1,154 @@
+/*
+ * purge.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_PURGE_H
+#define SQLPP_PURGE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <sqlpp11/type_traits.h>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/remove.h>
+#include <sqlpp11/select.h>
+#include <sqlpp11/in.h>
+#include <sqlpp11/create_table.h>
+#include <sqlpp11/transaction.h>
+
+namespace sqlpp
+{
+	// Whether purge batches are bounded by DELETE ... LIMIT, e.g.
+	//   DELETE FROM t WHERE condition LIMIT 1000
+	// instead of a sub-select on the primary key, e.g.
+	//   DELETE FROM t WHERE t.id IN (SELECT t.id FROM t WHERE condition LIMIT 1000)
+	// Connectors for dialects that support the former (e.g. MySQL, which rejects LIMIT in IN sub-selects) specialize this.
+	template<typename Context>
+		struct purge_uses_delete_limit_t: std::false_type
+		{};
+
+	namespace detail
+	{
+		template<typename Table, typename Condition>
+			auto make_purge_statement(Table table, Condition condition, int64_t batch_size, const std::true_type&)
+			-> decltype(remove_from(table).where(condition).limit(batch_size))
+			{
+				return remove_from(table).where(condition).limit(batch_size);
+			}
+
+		template<typename Table, typename Condition, typename Key = typename get_single_primary_key_column<Table>::type>
+			auto make_purge_statement(Table table, Condition condition, int64_t batch_size, const std::false_type&)
+			-> decltype(remove_from(table).where(Key{}.in(select(Key{}).from(table).where(condition).limit(batch_size))))
+			{
+				return remove_from(table).where(Key{}.in(select(Key{}).from(table).where(condition).limit(batch_size)));
+			}
+	}
+
+	// Deletes all rows of a table that match a condition in batches of at most batch_size rows:
+	//   purge(db, t, t.created < cutoff).run();
+	//
+	// Each batch is committed in its own transaction, so locks are held and the journal grows for one
+	// batch at a time only. The optional pause between batches gives concurrent readers and writers a
+	// chance to get in. Purging stops with the first batch that removes fewer than batch_size rows.
+	template<typename Db, typename Table, typename Condition>
+		class purge_t
+		{
+			using _uses_delete_limit = purge_uses_delete_limit_t<typename Db::_serializer_context_t>;
+			static_assert(_uses_delete_limit::value or get_primary_key_columns<Table>::type::size::value == 1, "purge() requires a table with a single primary key column");
+
+			using _statement_t = decltype(detail::make_purge_statement(std::declval<Table>(), std::declval<Condition>(), 0, _uses_delete_limit{}));
+			using _prepared_t = decltype(std::declval<Db&>().prepare(std::declval<const _statement_t&>()));
+
+		public:
+			purge_t(Db& db, Table table, Condition condition, std::size_t batch_size, std::chrono::milliseconds pause):
+				_db(db),
+				_batch_size(_checked_batch_size(batch_size)),
+				_pause(pause),
+				_prepared(db.prepare(detail::make_purge_statement(table, condition, static_cast<int64_t>(_batch_size), _uses_delete_limit{})))
+			{}
+
+			purge_t(const purge_t&) = delete;
+			purge_t(purge_t&&) = default;
+			purge_t& operator=(const purge_t&) = delete;
+			purge_t& operator=(purge_t&&) = delete;
+			~purge_t() = default;
+
+			// Removes all matching rows and returns their number
+			std::size_t run()
+			{
+				return run([](std::size_t, std::size_t){});
+			}
+
+			// Same as run(), calls progress(rows removed by the batch, rows removed so far) after each commit
+			template<typename Callback>
+				std::size_t run(Callback progress)
+				{
+					std::size_t total = 0;
+					while (true)
+					{
+						auto transaction = start_transaction(_db);
+						const std::size_t removed = _db(_prepared);
+						transaction.commit();
+
+						total += removed;
+						progress(removed, total);
+						if (removed < _batch_size)
+							return total;
+						if (_pause.count())
+							std::this_thread::sleep_for(_pause);
+					}
+				}
+
+		private:
+			// Called before anything is prepared
+			static std::size_t _checked_batch_size(std::size_t batch_size)
+			{
+				if (batch_size == 0)
+					throw exception("purge() requires a batch size greater than zero");
+				return batch_size;
+			}
+
+			Db& _db;
+			std::size_t _batch_size;
+			std::chrono::milliseconds _pause;
+			_prepared_t _prepared;
+		};
+
+	template<typename Db, typename Table, typename Condition>
+		purge_t<Db, Table, Condition> purge(Db& db, Table table, Condition condition,
+				std::size_t batch_size = 1000, std::chrono::milliseconds pause = std::chrono::milliseconds{0})
+		{
+			static_assert(is_raw_table_t<Table>::value, "purge() requires a table");
+			static_assert(is_boolean_t<Condition>::value, "purge() requires a boolean condition");
+			static_assert(detail::type_vector_size<parameters_of<Condition>>::value == 0, "purge() conditions must not contain parameters");
+			return {db, table, condition, batch_size, pause};
+		}
+}
+
+#endif
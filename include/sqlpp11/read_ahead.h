@@ -0,0 +1,168 @@
+/*
+ * read_ahead.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_READ_AHEAD_H
+#define SQLPP_READ_AHEAD_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sqlpp11/exception.h>
+
+namespace sqlpp
+{
+	// Fetches pages on a worker thread while the caller processes the previous ones:
+	//   auto pager = keyset_pager(export_db, select(t.id, t.name).from(t).where(true).order_by(t.id.asc()), 1000);
+	//   auto cursor = read_ahead(pager, [](const decltype(pager)::_row_t& row) { return Record{row.id, row.name}; });
+	//   std::vector<Record> page;
+	//   while (cursor.next(page))
+	//     ...
+	//
+	// The pager can be anything with done() and next(), where next() returns an iterable page, e.g.
+	// keyset_pager_t. It is driven by the worker thread only, so it has to use a connection of its own.
+	// Rows are converted to values on the worker thread because result rows refer to the connection.
+	// At most max_ready_pages converted pages are queued, the worker waits for the caller beyond that.
+	// Pages are handed out in order, exceptions of the worker are rethrown by next().
+	template<typename Value>
+		class read_ahead_t
+		{
+			struct _state_t
+			{
+				std::mutex _mutex;
+				std::condition_variable _ready;
+				std::condition_variable _consumed;
+				std::deque<std::vector<Value>> _pages;
+				std::size_t _max_ready_pages;
+				bool _finished = false;
+				bool _stopped = false;
+				std::exception_ptr _error;
+			};
+
+		public:
+			template<typename Pager, typename Convert>
+				read_ahead_t(Pager& pager, Convert convert, std::size_t max_ready_pages):
+					_state(new _state_t)
+			{
+				if (max_ready_pages == 0)
+					throw exception("read_ahead() requires at least one ready page");
+				_state->_max_ready_pages = max_ready_pages;
+				_worker = std::thread(&read_ahead_t::_fetch<Pager, Convert>, _state.get(), std::ref(pager), std::move(convert));
+			}
+
+			read_ahead_t(const read_ahead_t&) = delete;
+			read_ahead_t(read_ahead_t&&) = default;
+			read_ahead_t& operator=(const read_ahead_t&) = delete;
+			read_ahead_t& operator=(read_ahead_t&&) = delete;
+
+			// Stops fetching after the current page and waits for the worker
+			~read_ahead_t()
+			{
+				if (not _worker.joinable())
+					return;
+				{
+					std::lock_guard<std::mutex> lock(_state->_mutex);
+					_state->_stopped = true;
+				}
+				_state->_consumed.notify_one();
+				_worker.join();
+			}
+
+			// Waits for the next page and moves it into page, returns false after the last page
+			bool next(std::vector<Value>& page)
+			{
+				std::unique_lock<std::mutex> lock(_state->_mutex);
+				_state->_ready.wait(lock, [this]{ return not _state->_pages.empty() or _state->_finished; });
+				if (_state->_pages.empty())
+				{
+					if (_state->_error)
+						std::rethrow_exception(_state->_error);
+					return false;
+				}
+				page = std::move(_state->_pages.front());
+				_state->_pages.pop_front();
+				lock.unlock();
+				_state->_consumed.notify_one();
+				return true;
+			}
+
+		private:
+			template<typename Pager, typename Convert>
+				static void _fetch(_state_t* state, Pager& pager, Convert convert)
+				{
+					try
+					{
+						while (not pager.done())
+						{
+							std::vector<Value> page;
+							for (const auto& row : pager.next())
+								page.push_back(convert(row));
+							if (page.empty())
+								break;
+
+							std::unique_lock<std::mutex> lock(state->_mutex);
+							state->_consumed.wait(lock, [state]{ return state->_stopped or state->_pages.size() < state->_max_ready_pages; });
+							if (state->_stopped)
+								break;
+							state->_pages.push_back(std::move(page));
+							lock.unlock();
+							state->_ready.notify_one();
+						}
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(state->_mutex);
+						state->_error = std::current_exception();
+					}
+					{
+						std::lock_guard<std::mutex> lock(state->_mutex);
+						state->_finished = true;
+					}
+					state->_ready.notify_one();
+				}
+
+			std::unique_ptr<_state_t> _state;
+			std::thread _worker;
+		};
+
+	template<typename Pager, typename Convert>
+		auto read_ahead(Pager& pager, Convert convert, std::size_t max_ready_pages = 2)
+		-> read_ahead_t<typename std::decay<decltype(convert(*pager.next().begin()))>::type>
+		{
+			return {pager, convert, max_ready_pages};
+		}
+}
+
+#endif
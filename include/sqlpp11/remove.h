@@ -37,6 +37,9 @@
 #include <sqlpp11/extra_tables.h>
 #include <sqlpp11/using.h>
 #include <sqlpp11/where.h>
+#include <sqlpp11/limit.h>
+#include <sqlpp11/returning.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
@@ -75,14 +78,14 @@ namespace sqlpp
 					auto _prepare(Db& db, const Composite& composite) const
 					-> prepared_remove_t<Db, Composite>
 					{
-						return {{}, db.prepare_remove(composite)};
+						return {{}, {}, db.prepare_remove(composite)};
 					}
 
 				template<typename Db>
 					auto _prepare(Db& db) const
 					-> prepared_remove_t<Db, _statement_t>
 					{
-						return {{}, db.prepare_remove(_get_statement())};
+						return {{}, _get_statement()._get_dynamic_parameters(), db.prepare_remove(_get_statement())};
 					}
 			};
 	};
@@ -102,13 +105,22 @@ namespace sqlpp
 			}
 		};
 
+	template<>
+		struct static_sql_t<remove_name_t>
+		{
+			static constexpr const char _literal[] = "DELETE";
+			using type = make_static_sql_literal<sizeof(_literal), _literal>;
+		};
+
 	template<typename Database>
 		using blank_remove_t = statement_t<Database,
 					remove_t,
 					no_from_t,
 					no_using_t,
 					no_extra_tables_t,
-					no_where_t<true>
+					no_where_t<true>,
+					no_limit_t,
+					no_returning_t
 						>;
 
 	inline auto remove()
@@ -27,9 +27,11 @@
 #ifndef SQLPP_RESULT_ROW_H
 #define SQLPP_RESULT_ROW_H
 
-#include <map>
+#include <stdexcept>
+#include <vector>
 #include <sqlpp11/result_row_fwd.h>
 #include <sqlpp11/field_spec.h>
+#include <sqlpp11/dynamic_field_names.h>
 #include <sqlpp11/text.h>
 #include <sqlpp11/detail/field_index_sequence.h>
 
@@ -139,9 +141,22 @@ namespace sqlpp
 		}
 
 		result_row_t(const result_row_t&) = delete;
-		result_row_t(result_row_t&&) = default;
 		result_row_t& operator=(const result_row_t&) = delete;
-		result_row_t& operator=(result_row_t&&) = default;
+		// The fields of a moved row live at a new address, so it has to be bound again
+		result_row_t(result_row_t&& rhs):
+			_impl(std::move(rhs)),
+			_is_valid(rhs._is_valid),
+			_bound_target(nullptr)
+		{
+		}
+
+		result_row_t& operator=(result_row_t&& rhs)
+		{
+			_impl::operator=(std::move(rhs));
+			_is_valid = rhs._is_valid;
+			_bound_target = nullptr;
+			return *this;
+		}
 
 		void _validate()
 		{
@@ -174,7 +189,19 @@ namespace sqlpp
 			void _bind(Target& target)
 			{
 				_impl::_bind(target);
+				_bound_target = &target;
+			}
+
+		// Binds the fields unless they are bound to target already, see connector_api/bind_result.h
+		template<typename Target>
+			void _bind_once(Target& target)
+			{
+				if (_bound_target != &target)
+					_bind(target);
 			}
+
+	private:
+		const void* _bound_target = nullptr;
 	};
 
 	template<typename Db, typename... FieldSpecs>
@@ -192,8 +219,8 @@ namespace sqlpp
 		using _field_type = result_field_t<text, Db, _field_spec_t>;
 
 		bool _is_valid;
-		std::vector<std::string> _dynamic_field_names;
-		std::map<std::string, _field_type> _dynamic_fields;
+		dynamic_field_names_t _dynamic_field_names;
+		std::vector<_field_type> _dynamic_fields;
 
 		dynamic_result_row_t(): 
 			_impl(),
@@ -201,21 +228,34 @@ namespace sqlpp
 		{
 		}
 
-		dynamic_result_row_t(const std::vector<std::string>& dynamic_field_names): 
+		dynamic_result_row_t(const dynamic_field_names_t& dynamic_field_names): 
 			_impl(),
 			_is_valid(false),
-			_dynamic_field_names(dynamic_field_names)
+			_dynamic_field_names(dynamic_field_names),
+			_dynamic_fields(dynamic_field_names.size())
 		{
-			for (auto field_name : _dynamic_field_names)
-			{
-				_dynamic_fields.insert({field_name, _field_type{}});
-			}
 		}
 
 		dynamic_result_row_t(const dynamic_result_row_t&) = delete;
-		dynamic_result_row_t(dynamic_result_row_t&&) = default;
 		dynamic_result_row_t& operator=(const dynamic_result_row_t&) = delete;
-		dynamic_result_row_t& operator=(dynamic_result_row_t&&) = default;
+		dynamic_result_row_t(dynamic_result_row_t&& rhs):
+			_impl(std::move(rhs)),
+			_is_valid(rhs._is_valid),
+			_dynamic_field_names(std::move(rhs._dynamic_field_names)),
+			_dynamic_fields(std::move(rhs._dynamic_fields)),
+			_bound_target(nullptr)
+		{
+		}
+
+		dynamic_result_row_t& operator=(dynamic_result_row_t&& rhs)
+		{
+			_impl::operator=(std::move(rhs));
+			_is_valid = rhs._is_valid;
+			_dynamic_field_names = std::move(rhs._dynamic_field_names);
+			_dynamic_fields = std::move(rhs._dynamic_fields);
+			_bound_target = nullptr;
+			return *this;
+		}
 
 		void _validate()
 		{
@@ -224,7 +264,7 @@ namespace sqlpp
 			_is_valid = true;
 			for (auto& field : _dynamic_fields)
 			{
-				field.second._validate();
+				field._validate();
 			}
 		}
 
@@ -234,7 +274,7 @@ namespace sqlpp
 			_is_valid = false;
 			for (auto& field : _dynamic_fields)
 			{
-				field.second._invalidate();
+				field._invalidate();
 			}
 		}
 
@@ -245,7 +285,26 @@ namespace sqlpp
 
 		const _field_type& at(const std::string& field_name) const
 		{
-			return _dynamic_fields.at(field_name);
+			return at(handle(field_name));
+		}
+
+		// Resolve a dynamic column once and use the handle for all rows of the result
+		dynamic_field_handle_t handle(const std::string& field_name) const
+		{
+			const auto index = _dynamic_field_names.find(field_name);
+			if (index == _dynamic_fields.size())
+				throw std::out_of_range("unknown dynamic field: " + field_name);
+			return {index};
+		}
+
+		const _field_type& at(const dynamic_field_handle_t& handle) const
+		{
+			return _dynamic_fields[handle._index];
+		}
+
+		const _field_type& operator[](const dynamic_field_handle_t& handle) const
+		{
+			return _dynamic_fields[handle._index];
 		}
 
 		explicit operator bool() const
@@ -259,12 +318,23 @@ namespace sqlpp
 				_impl::_bind(target);
 
 				std::size_t index = _field_index_sequence::_next_index;
-				for (const auto& field_name : _dynamic_field_names)
+				for (auto& field : _dynamic_fields)
 				{
-					_dynamic_fields.at(field_name)._bind(target, index);
+					field._bind(target, index);
 					++index;
 				}
+				_bound_target = &target;
 			}
+
+		template<typename Target>
+			void _bind_once(Target& target)
+			{
+				if (_bound_target != &target)
+					_bind(target);
+			}
+
+	private:
+		const void* _bound_target = nullptr;
 	};
 
 	template<typename T>
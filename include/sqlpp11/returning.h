@@ -0,0 +1,293 @@
+/*
+ * returning.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_RETURNING_H
+#define SQLPP_RETURNING_H
+
+#include <sqlpp11/type_traits.h>
+#include <sqlpp11/logic.h>
+#include <sqlpp11/no_data.h>
+#include <sqlpp11/policy_update.h>
+#include <sqlpp11/interpret_tuple.h>
+#include <sqlpp11/select_column_list.h>
+#include <sqlpp11/prepared_select.h>
+#include <sqlpp11/result.h>
+#include <sqlpp11/detail/type_set.h>
+
+namespace sqlpp
+{
+	// RETURNING DATA
+	template<typename... Columns>
+		struct returning_data_t
+		{
+			returning_data_t(std::tuple<Columns...> columns):
+				_columns(columns)
+			{}
+
+			returning_data_t(const returning_data_t&) = default;
+			returning_data_t(returning_data_t&&) = default;
+			returning_data_t& operator=(const returning_data_t&) = default;
+			returning_data_t& operator=(returning_data_t&&) = default;
+			~returning_data_t() = default;
+
+			std::tuple<Columns...> _columns;
+		};
+
+	struct assert_no_unknown_tables_in_returning_t
+	{
+		using type = std::false_type;
+
+		template<typename T = void>
+		static void _()
+		{
+			static_assert(wrong_t<T>::value, "at least one returned expression requires a table which is otherwise not known in the statement");
+		}
+	};
+
+	// RETURNING
+	//
+	// Turns an insert, update or remove into a statement with a result, typed like the result of a
+	// select with the same columns. It is run via the connection's select() and prepare_select(),
+	// which therefore have to accept these statements, too.
+	template<typename... Columns>
+		struct returning_t
+		{
+			using _traits = make_traits<no_value_t, tag::is_return_value>;
+			using _nodes = detail::type_vector<Columns...>;
+
+			struct _alias_t {};
+
+			// Data
+			using _data_t = returning_data_t<Columns...>;
+
+			// Member implementation with data and methods
+			template<typename Policies>
+				struct _impl_t
+				{
+					_data_t _data;
+				};
+
+			// Base template to be inherited by the statement
+			template<typename Policies>
+				struct _base_t
+				{
+					using _data_t = returning_data_t<Columns...>;
+
+					_impl_t<Policies> returning;
+					_impl_t<Policies>& operator()() { return returning; }
+					const _impl_t<Policies>& operator()() const { return returning; }
+
+					template<typename T>
+						static auto _get_member(T t) -> decltype(t.returning)
+						{
+							return t.returning;
+						}
+
+					using _consistency_check = typename std::conditional<Policies::template _no_unknown_tables<returning_t>::value,
+								consistent_t,
+								assert_no_unknown_tables_in_returning_t>::type;
+				};
+
+			// Result methods
+			template<typename Statement>
+				struct _result_methods_t
+				{
+					using _statement_t = Statement;
+
+					const _statement_t& _get_statement() const
+					{
+						return static_cast<const _statement_t&>(*this);
+					}
+
+					template<typename Db, typename Column>
+					 struct	_deferred_field_t
+					 {
+						 using type = make_field_spec_t<_statement_t, Column>;
+					 };
+
+					template<typename Db, typename Column>
+						using _field_t = typename _deferred_field_t<Db, Column>::type;
+
+					template<typename Db>
+						using _result_row_t = result_row_t<Db, _field_t<Db, Columns>...>;
+
+					using _dynamic_names_t = typename dynamic_select_column_list<void>::_names_t;
+
+					_dynamic_names_t get_dynamic_names() const
+					{
+						return {};
+					}
+
+					size_t get_no_of_result_columns() const
+					{
+						return sizeof...(Columns);
+					}
+
+					// Execute
+					template<typename Db, typename Composite>
+						auto _run(Db& db, const Composite& composite) const
+						-> result_t<decltype(db.select(composite)), _result_row_t<Db>>
+						{
+							return {db.select(composite), get_dynamic_names()};
+						}
+
+					template<typename Db>
+						auto _run(Db& db) const
+						-> result_t<decltype(db.select(std::declval<_statement_t>())), _result_row_t<Db>>
+						{
+							return {db.select(_get_statement()), get_dynamic_names()};
+						}
+
+					// Prepare
+					template<typename Db, typename Composite>
+						auto _prepare(Db& db, const Composite& composite) const
+						-> prepared_select_t<Db, _statement_t, Composite>
+						{
+							return {make_parameter_list_t<Composite>{}, get_dynamic_names(), {}, db.prepare_select(composite)};
+						}
+
+					template<typename Db>
+						auto _prepare(Db& db) const
+						-> prepared_select_t<Db, _statement_t>
+						{
+							return {make_parameter_list_t<_statement_t>{}, get_dynamic_names(), _get_statement()._get_dynamic_parameters(), db.prepare_select(_get_statement())};
+						}
+				};
+		};
+
+	namespace detail
+	{
+		template<typename ColumnTuple>
+			struct make_returning_impl;
+
+		template<typename... Columns>
+			struct make_returning_impl<std::tuple<Columns...>>
+			{
+				using type = returning_t<Columns...>;
+			};
+
+		template<typename... Columns>
+			using make_returning_t = typename make_returning_impl<decltype(tuple_merge(std::declval<Columns>()...))>::type;
+	}
+
+	// NO RETURNING YET
+	struct no_returning_t
+	{
+		using _traits = make_traits<no_value_t, tag::is_noop>;
+		using _nodes = detail::type_vector<>;
+
+		// Data
+		using _data_t = no_data_t;
+
+		// Member implementation with data and methods
+		template<typename Policies>
+			struct _impl_t
+			{
+				_data_t _data;
+			};
+
+		// Base template to be inherited by the statement
+		template<typename Policies>
+			struct _base_t
+			{
+				using _data_t = no_data_t;
+
+				_impl_t<Policies> no_returning;
+				_impl_t<Policies>& operator()() { return no_returning; }
+				const _impl_t<Policies>& operator()() const { return no_returning; }
+
+				template<typename T>
+					static auto _get_member(T t) -> decltype(t.no_returning)
+					{
+						return t.no_returning;
+					}
+
+				template<typename... T>
+					using _check = logic::all_t<is_selectable_t<T>::value...>;
+
+				template<typename... T>
+					static constexpr auto _check_tuple(std::tuple<T...>) -> _check<T...>
+					{
+						return {};
+					}
+
+				template<typename... T>
+					static constexpr auto _check_args(T... args) -> decltype(_check_tuple(detail::tuple_merge(args...)))
+					{
+						return _check_tuple(detail::tuple_merge(args...));
+					}
+
+				template<typename Check, typename T>
+					using _new_statement_t = new_statement_t<Check::value, Policies, no_returning_t, T>;
+
+				using _consistency_check = consistent_t;
+
+				template<typename... Args>
+					auto returning(Args... args) const
+					-> _new_statement_t<decltype(_check_args(args...)), detail::make_returning_t<Args...>>
+					{
+						static_assert(sizeof...(Args), "at least one selectable expression (e.g. a column) required in returning()");
+						static_assert(decltype(_check_args(args...))::value, "at least one argument is not a selectable expression in returning()");
+
+						return _returning_impl(_check_args(args...), detail::tuple_merge(args...));
+					}
+
+			private:
+				template<typename... Args>
+					auto _returning_impl(const std::false_type&, std::tuple<Args...> args) const
+					-> bad_statement;
+
+				template<typename... Args>
+					auto _returning_impl(const std::true_type&, std::tuple<Args...> args) const
+					-> _new_statement_t<std::true_type, returning_t<Args...>>
+					{
+						static_assert(not detail::has_duplicates<Args...>::value, "at least one duplicate argument detected in returning()");
+						static_assert(not detail::has_duplicates<typename Args::_alias_t...>::value, "at least one duplicate name detected in returning()");
+
+						return { static_cast<const derived_statement_t<Policies>&>(*this), returning_data_t<Args...>{args} };
+					}
+			};
+	};
+
+	// Interpreters
+	template<typename Context, typename... Columns>
+		struct serializer_t<Context, returning_data_t<Columns...>>
+		{
+			using _serialize_check = serialize_check_of<Context, Columns...>;
+			using T = returning_data_t<Columns...>;
+
+			static Context& _(const T& t, Context& context)
+			{
+				context << " RETURNING ";
+				interpret_tuple(t._columns, ',', context);
+				return context;
+			}
+		};
+}
+
+#endif
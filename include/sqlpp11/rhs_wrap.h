@@ -30,6 +30,7 @@
 #include <sqlpp11/tvin.h>
 #include <sqlpp11/default_value.h>
 #include <sqlpp11/null.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
@@ -168,6 +169,13 @@ namespace sqlpp
 			}
 		};
 
+	// Expressions with static text are never NULL or DEFAULT
+	template<typename Expr, bool TrivialValueIsNull>
+		struct static_sql_t<rhs_wrap_t<Expr, TrivialValueIsNull>>
+		{
+			using type = static_sql_of<Expr>;
+		};
+
 }
 
 #endif
@@ -45,6 +45,7 @@
 #include <sqlpp11/union.h>
 #include <sqlpp11/expression.h>
 #include <sqlpp11/wrong.h>
+#include <sqlpp11/static_sql.h>
 
 
 namespace sqlpp
@@ -68,6 +69,13 @@ namespace sqlpp
 			}
 		};
 
+	template<>
+		struct static_sql_t<select_name_t>
+		{
+			static constexpr const char _literal[] = "SELECT ";
+			using type = make_static_sql_literal<sizeof(_literal), _literal>;
+		};
+
 	template<typename Database>
 		using blank_select_t = statement_t<Database,
 					no_with_t,
@@ -29,6 +29,7 @@
 
 #include <tuple>
 #include <sqlpp11/result_row.h>
+#include <sqlpp11/dynamic_field_names.h>
 #include <sqlpp11/table.h>
 #include <sqlpp11/no_value.h>
 #include <sqlpp11/no_data.h>
@@ -36,8 +37,10 @@
 #include <sqlpp11/expression_fwd.h>
 #include <sqlpp11/select_pseudo_table.h>
 #include <sqlpp11/named_interpretable.h>
+#include <sqlpp11/interpretable_list.h>
 #include <sqlpp11/interpret_tuple.h>
 #include <sqlpp11/policy_update.h>
+#include <sqlpp11/static_sql.h>
 #include <sqlpp11/detail/type_set.h>
 #include <sqlpp11/detail/copy_tuple_args.h>
 
@@ -63,7 +66,7 @@ namespace sqlpp
 	template<typename Db>
 		struct dynamic_select_column_list
 		{
-			using _names_t = std::vector<std::string>;
+			using _names_t = dynamic_field_names_t;
 			std::vector<named_interpretable_t<Db>> _dynamic_columns;
 			_names_t _dynamic_expression_names;
 
@@ -71,6 +74,8 @@ namespace sqlpp
 				void emplace_back(Expr expr)
 				{
 					_dynamic_expression_names.push_back(name_of<Expr>::char_ptr());
+					if (_dynamic_columns.empty())
+						_dynamic_columns.reserve(8);
 					_dynamic_columns.emplace_back(expr);
 				}
 
@@ -78,6 +83,13 @@ namespace sqlpp
 			{
 				return _dynamic_columns.empty();
 			}
+
+			template<typename Visitor>
+				void _visit(Visitor& visitor) const
+				{
+					for (const auto& column : _dynamic_columns)
+						visitor._visit_part(column);
+				}
 		};
 
 	template<>
@@ -93,6 +105,10 @@ namespace sqlpp
 			{
 				return true;
 			}
+
+			template<typename Visitor>
+				void _visit(Visitor&) const
+				{}
 		};
 
 	template<typename Context, typename Db>
@@ -103,7 +119,7 @@ namespace sqlpp
 			static Context& _(const T& t, Context& context)
 			{
 				bool first = true;
-				for (const auto column : t._dynamic_columns)
+				for (const auto& column : t._dynamic_columns)
 				{
 					if (first)
 						first = false;
@@ -323,14 +339,14 @@ namespace sqlpp
 						auto _prepare(Db& db, const Composite& composite) const
 						-> prepared_select_t<Db, _statement_t, Composite>
 						{
-							return {make_parameter_list_t<Composite>{}, get_dynamic_names(), db.prepare_select(composite)};
+							return {make_parameter_list_t<Composite>{}, get_dynamic_names(), {}, db.prepare_select(composite)};
 						}
 
 					template<typename Db>
 						auto _prepare(Db& db) const
 						-> prepared_select_t<Db, _statement_t>
 						{
-							return {make_parameter_list_t<_statement_t>{}, get_dynamic_names(), db.prepare_select(_get_statement())};
+							return {make_parameter_list_t<_statement_t>{}, get_dynamic_names(), _get_statement()._get_dynamic_parameters(), db.prepare_select(_get_statement())};
 						}
 				};
 
@@ -443,6 +459,16 @@ namespace sqlpp
 			};
 	};
 
+	template<typename Database, typename... Columns>
+		struct dynamic_parts_t<select_column_list_data_t<Database, Columns...>>
+		{
+			template<typename Visitor>
+				static void _(const select_column_list_data_t<Database, Columns...>& t, Visitor& visitor)
+				{
+					t._dynamic_columns._visit(visitor);
+				}
+		};
+
 	// Interpreters
 	template<typename Context, typename Database, typename... Columns>
 		struct serializer_t<Context, select_column_list_data_t<Database, Columns...>>
@@ -460,6 +486,18 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Database, typename... Columns>
+		struct static_part_of_t<select_column_list_data_t<Database, Columns...>>
+		{
+			using type = select_column_list_data_t<void, Columns...>;
+		};
+
+	template<typename... Columns>
+		struct static_sql_t<select_column_list_data_t<void, Columns...>>
+		{
+			using type = static_sql_join_t<char_sequence<','>, static_sql_operand_of<Columns>...>;
+		};
+
 	template<typename... T>
 		auto select_columns(T&&... t) -> decltype(statement_t<void, no_select_column_list_t>().columns(std::forward<T>(t)...))
 		{
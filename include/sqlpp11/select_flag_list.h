@@ -33,7 +33,9 @@
 #include <sqlpp11/select_flags.h>
 #include <sqlpp11/detail/type_set.h>
 #include <sqlpp11/interpret_tuple.h>
+#include <sqlpp11/interpretable_list.h>
 #include <sqlpp11/policy_update.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
@@ -203,6 +205,16 @@ namespace sqlpp
 	};
 
 
+	template<typename Database, typename... Flags>
+		struct dynamic_parts_t<select_flag_list_data_t<Database, Flags...>>
+		{
+			template<typename Visitor>
+				static void _(const select_flag_list_data_t<Database, Flags...>& t, Visitor& visitor)
+				{
+					t._dynamic_flags._visit(visitor);
+				}
+		};
+
 	// Interpreters
 	template<typename Context, typename Database, typename... Flags>
 		struct serializer_t<Context, select_flag_list_data_t<Database, Flags...>>
@@ -222,6 +234,19 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Database, typename... Flags>
+		struct static_part_of_t<select_flag_list_data_t<Database, Flags...>>
+		{
+			using type = select_flag_list_data_t<void, Flags...>;
+		};
+
+	template<typename... Flags>
+		struct static_sql_t<select_flag_list_data_t<void, Flags...>>
+		{
+			using type = static_sql_cat_t<static_sql_join_t<char_sequence<' '>, static_sql_operand_of<Flags>...>,
+						typename std::conditional<sizeof...(Flags) != 0, char_sequence<' '>, char_sequence<>>::type>;
+		};
+
 
 }
 
@@ -30,6 +30,7 @@
 #include <sqlpp11/type_traits.h>
 #include <sqlpp11/detail/type_set.h>
 #include <sqlpp11/interpret_tuple.h>
+#include <sqlpp11/static_sql.h>
 #include <tuple>
 
 namespace sqlpp
@@ -54,6 +55,13 @@ namespace sqlpp
 			}
 		};
 
+	template<>
+		struct static_sql_t<all_t>
+		{
+			static constexpr const char _literal[] = "ALL";
+			using type = make_static_sql_literal<sizeof(_literal), _literal>;
+		};
+
 	struct distinct_t
 	{
 		using _traits = make_traits<no_value_t, tag::is_select_flag>;
@@ -73,6 +81,13 @@ namespace sqlpp
 			}
 		};
 
+	template<>
+		struct static_sql_t<distinct_t>
+		{
+			static constexpr const char _literal[] = "DISTINCT";
+			using type = make_static_sql_literal<sizeof(_literal), _literal>;
+		};
+
 	struct straight_join_t
 	{
 		using _traits = make_traits<no_value_t, tag::is_select_flag>;
@@ -92,6 +107,13 @@ namespace sqlpp
 			}
 		};
 
+	template<>
+		struct static_sql_t<straight_join_t>
+		{
+			static constexpr const char _literal[] = "STRAIGHT_JOIN";
+			using type = make_static_sql_literal<sizeof(_literal), _literal>;
+		};
+
 }
 
 #endif
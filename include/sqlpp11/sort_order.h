@@ -29,6 +29,7 @@
 
 #include <sqlpp11/detail/type_set.h>
 #include <sqlpp11/no_value.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
@@ -69,6 +70,17 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Expression, sort_type SortType>
+		struct static_sql_t<sort_order_t<Expression, SortType>>
+		{
+			static constexpr const char _asc[] = " ASC";
+			static constexpr const char _desc[] = " DESC";
+			using type = static_sql_cat_t<static_sql_operand_of<Expression>,
+						typename std::conditional<SortType == sort_type::asc,
+							make_static_sql_literal<sizeof(_asc), _asc>,
+							make_static_sql_literal<sizeof(_desc), _desc>>::type>;
+		};
+
 }
 
 #endif
@@ -29,11 +29,16 @@
 
 #include <sqlpp11/result.h>
 #include <sqlpp11/parameter_list.h>
+#include <sqlpp11/dynamic_parameter_list.h>
+#include <sqlpp11/interpretable_list.h>
+#include <sqlpp11/statement_shape.h>
+#include <sqlpp11/exception.h>
 #include <sqlpp11/prepared_select.h>
 #include <sqlpp11/serialize.h>
 #include <sqlpp11/noop.h>
 #include <sqlpp11/policy_update.h>
 #include <sqlpp11/serializer.h>
+#include <sqlpp11/static_sql.h>
 
 #include <sqlpp11/detail/get_first.h>
 #include <sqlpp11/detail/get_last.h>
@@ -229,9 +234,40 @@ namespace sqlpp
 
 		size_t _get_no_of_parameters() const
 		{
-			return _get_static_no_of_parameters();
+			dynamic_parameter_counter_t counter;
+			_visit_dynamic_parts(counter);
+			return _get_static_no_of_parameters() + counter._count;
 		}
 
+		// Placeholder layout of static and dynamic parameters, computed once when the statement is prepared
+		dynamic_parameter_list_t _get_dynamic_parameters() const
+		{
+			dynamic_parameter_list_t list;
+			_visit_dynamic_parts(list);
+			return list;
+		}
+
+		using _static_part_has_static_sql = logic::all_t<has_static_sql_t<
+			typename static_part_of_t<typename Policies::template _base_t<_policies_t>::_data_t>::type>::value...>;
+
+		statement_shape_t _get_shape() const
+		{
+			statement_shape_t shape(typeid(statement_t), _static_part_has_static_sql::value);
+			_visit_dynamic_parts(shape);
+			return shape;
+		}
+
+		// Calls visitor._visit_clause(no_of_static_parameters) for each clause, followed by
+		// visitor._visit_part(part) for each of its dynamic parts, in serialization order
+		template<typename Visitor>
+			void _visit_dynamic_parts(Visitor& visitor) const
+			{
+				using swallow = int[];  // see interpret_tuple.h
+				(void) swallow{0, (visitor._visit_clause(detail::type_vector_size<parameters_of<Policies>>::value),
+						dynamic_parts_t<typename Policies::template _base_t<_policies_t>::_data_t>::_(
+							static_cast<const typename Policies::template _base_t<_policies_t>&>(*this)()._data, visitor), 0)...};
+			}
+
 		static constexpr bool _can_be_used_as_table()
 		{
 			return _policies_t::_can_be_used_as_table();
@@ -241,6 +277,8 @@ namespace sqlpp
 		auto _run(Database& db) const	-> decltype(std::declval<_result_methods_t<statement_t>>()._run(db))
 		{
 			_run_check::_();
+			if (_get_no_of_parameters())
+				throw exception("sqlpp::statement_t: statements with parameters in dynamic parts need to be prepared");
 			return _result_methods_t<statement_t>::_run(db);
 		}
 
@@ -261,12 +299,32 @@ namespace sqlpp
 			using T = statement_t<Database, Policies...>;
 
 			static Context& _(const T& t, Context& context)
+			{
+				return _impl(t, context, std::integral_constant<bool, uses_static_sql_t<Context>::value and has_static_sql_t<T>::value>{});
+			}
+
+		private:
+			static Context& _impl(const T& t, Context& context, const std::false_type&)
 			{
 				using swallow = int[]; 
 				(void) swallow{(serialize(static_cast<const typename Policies::template _base_t<P>&>(t)()._data, context), 0)...};
 
 				return context;
 			}
+
+			static Context& _impl(const T& , Context& context, const std::true_type&)
+			{
+				context << static_sql_text_t<T>::_text;
+				return context;
+			}
+		};
+
+	// A statement's text is known at compile time if the text of each of its parts is
+	template<typename Database, typename... Policies>
+		struct static_sql_t<statement_t<Database, Policies...>>
+		{
+			using P = detail::statement_policies_t<Database, Policies...>;
+			using type = static_sql_cat_t<static_sql_of<typename Policies::template _base_t<P>::_data_t>...>;
 		};
 
 	template<typename NameData, typename Tag = tag::is_noop>
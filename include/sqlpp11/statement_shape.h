@@ -0,0 +1,141 @@
+/*
+ * statement_shape.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_STATEMENT_SHAPE_H
+#define SQLPP_STATEMENT_SHAPE_H
+
+#include <cstddef>
+#include <functional>
+#include <typeindex>
+#include <typeinfo>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sqlpp11/static_sql.h>
+
+namespace sqlpp
+{
+	// Fingerprint of a statement instance: its type plus the types of its dynamic parts, in
+	// serialization order. Computed without serializing anything.
+	//
+	// Two statements with the same shape serialize to the same text, if determines_sql() is true,
+	// i.e. if neither the static nor the dynamic parts contain literal values or other runtime
+	// data (see static_sql.h). Connections can then map the shape to an already prepared statement,
+	// see prepared_statement_cache.h.
+	class statement_shape_t
+	{
+	public:
+		statement_shape_t(const std::type_info& type, bool determines_sql):
+			_type(type),
+			_hash(std::hash<std::type_index>{}(_type)),
+			_determines_sql(determines_sql)
+		{}
+
+		std::size_t hash() const
+		{
+			return _hash;
+		}
+
+		bool determines_sql() const
+		{
+			return _determines_sql;
+		}
+
+		std::size_t size() const
+		{
+			return _parts.size();
+		}
+
+		bool operator==(const statement_shape_t& rhs) const
+		{
+			return _hash == rhs._hash and _type == rhs._type and _parts == rhs._parts;
+		}
+
+		bool operator!=(const statement_shape_t& rhs) const
+		{
+			return not operator==(rhs);
+		}
+
+		// Visitor interface, see statement_t::_visit_dynamic_parts()
+		void _visit_clause(std::size_t)
+		{}
+
+		template<typename Part>
+			void _visit_part(const Part& part)
+			{
+				if (_parts.empty())
+					_parts.reserve(8);
+				_parts.emplace_back(part._get_type());
+				_hash ^= std::hash<std::type_index>{}(_parts.back()) + 0x9e3779b9 + (_hash << 6) + (_hash >> 2);
+				_determines_sql = _determines_sql and part._has_static_sql;
+			}
+
+	private:
+		std::type_index _type;
+		std::vector<std::type_index> _parts;
+		std::size_t _hash;
+		bool _determines_sql;
+	};
+
+	struct statement_shape_hash_t
+	{
+		std::size_t operator()(const statement_shape_t& shape) const
+		{
+			return shape.hash();
+		}
+	};
+
+	namespace detail
+	{
+		template<typename T, typename Enable = void>
+			struct shape_of_impl
+			{
+				static statement_shape_t _(const T&)
+				{
+					return {typeid(T), has_static_sql_t<T>::value};
+				}
+			};
+
+		template<typename T>
+			struct shape_of_impl<T, typename std::enable_if<std::is_class<decltype(std::declval<const T&>()._get_shape())>::value>::type>
+			{
+				static statement_shape_t _(const T& t)
+				{
+					return t._get_shape();
+				}
+			};
+	}
+
+	template<typename T>
+		statement_shape_t shape_of(const T& t)
+		{
+			return detail::shape_of_impl<T>::_(t);
+		}
+}
+
+#endif
@@ -0,0 +1,201 @@
+/*
+ * static_sql.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_STATIC_SQL_H
+#define SQLPP_STATIC_SQL_H
+
+#include <type_traits>
+#include <sqlpp11/char_sequence.h>
+#include <sqlpp11/type_traits.h>
+#include <sqlpp11/logic.h>
+#include <sqlpp11/wrong.h>
+#include <sqlpp11/detail/index_sequence.h>
+
+namespace sqlpp
+{
+	// static_sql_t<T>::type is the SQL text of T as a char_sequence (without a
+	// terminating null), if that text is fully determined by the type of T,
+	// e.g. for columns, parameters and statements without dynamic parts or
+	// literal values. Otherwise it is void.
+	//
+	// Node types that qualify specialize static_sql_t next to their serializer_t
+	// specialization. The text has to match the serializer's output exactly.
+	template<typename T, typename Enable = void>
+		struct static_sql_t
+		{
+			using type = void;
+		};
+
+	template<typename T>
+		using static_sql_of = typename static_sql_t<T>::type;
+
+	template<typename T>
+		using has_static_sql_t = std::integral_constant<bool, not std::is_same<static_sql_of<T>, void>::value>;
+
+	// The data of a clause without its dynamic parts, e.g. where_data_t<void, Expressions...> for
+	// where_data_t<Db, Expressions...>. Specialized next to the static_sql_t specialization of such
+	// data types. Used for statement shapes, see statement_shape.h
+	template<typename Data>
+		struct static_part_of_t
+		{
+			using type = Data;
+		};
+
+	namespace detail
+	{
+		template<typename Result, typename Sequence>
+			struct strip_null_impl;
+
+		template<char... Rs>
+			struct strip_null_impl<char_sequence<Rs...>, char_sequence<>>
+			{
+				using type = char_sequence<Rs...>;
+			};
+
+		template<char... Rs, char... Cs>
+			struct strip_null_impl<char_sequence<Rs...>, char_sequence<'\0', Cs...>>
+			{
+				using type = typename strip_null_impl<char_sequence<Rs...>, char_sequence<Cs...>>::type;
+			};
+
+		template<char... Rs, char C, char... Cs>
+			struct strip_null_impl<char_sequence<Rs...>, char_sequence<C, Cs...>>
+			{
+				using type = typename strip_null_impl<char_sequence<Rs..., C>, char_sequence<Cs...>>::type;
+			};
+
+		template<typename... Sequences>
+			struct char_sequence_cat_impl;
+
+		template<>
+			struct char_sequence_cat_impl<>
+			{
+				using type = char_sequence<>;
+			};
+
+		template<char... Cs>
+			struct char_sequence_cat_impl<char_sequence<Cs...>>
+			{
+				using type = char_sequence<Cs...>;
+			};
+
+		template<char... As, char... Bs, typename... Rest>
+			struct char_sequence_cat_impl<char_sequence<As...>, char_sequence<Bs...>, Rest...>
+			{
+				using type = typename char_sequence_cat_impl<char_sequence<As..., Bs...>, Rest...>::type;
+			};
+
+		template<typename T>
+			struct static_sql_identity
+			{
+				using type = T;
+			};
+
+		template<typename Separator, typename... Parts>
+			struct static_sql_join_impl;
+	}
+
+	// The text of a literal without its terminating null
+	template<std::size_t N, const char (&Input) [N]>
+		using make_static_sql_literal = typename make_char_sequence_impl<N, Input, detail::make_index_sequence<N - 1>>::type;
+
+	// The name of T (e.g. a table or column) without its terminating null
+	template<typename T>
+		using static_sql_name_of = typename detail::strip_null_impl<char_sequence<>, name_of<T>>::type;
+
+	// Concatenates the parts, void if any of them is void
+	template<typename... Parts>
+		using static_sql_cat_t = typename std::conditional<logic::any_t<std::is_same<Parts, void>::value...>::value,
+					detail::static_sql_identity<void>,
+					detail::char_sequence_cat_impl<Parts...>>::type::type;
+
+	// Concatenates the parts with the separator in between, void if any of them is void
+	template<typename Separator, typename... Parts>
+		using static_sql_join_t = typename detail::static_sql_join_impl<Separator, Parts...>::type;
+
+	// The text of T as written by serialize_operand
+	template<typename T>
+		using static_sql_operand_of = typename std::conditional<requires_braces_t<T>::value,
+					static_sql_cat_t<char_sequence<'('>, static_sql_of<T>, char_sequence<')'>>,
+					static_sql_of<T>>::type;
+
+	namespace detail
+	{
+		template<typename Separator>
+			struct static_sql_join_impl<Separator>
+			{
+				using type = char_sequence<>;
+			};
+
+		template<typename Separator, typename Part>
+			struct static_sql_join_impl<Separator, Part>
+			{
+				using type = Part;
+			};
+
+		template<typename Separator, typename First, typename Second, typename... Rest>
+			struct static_sql_join_impl<Separator, First, Second, Rest...>
+			{
+				using type = static_sql_cat_t<First, Separator, typename static_sql_join_impl<Separator, Second, Rest...>::type>;
+			};
+	}
+
+	// Null terminated text of T, usable at compile time and without any runtime serialization
+	template<typename T, typename Sequence = static_sql_of<T>>
+		struct static_sql_text_t
+		{
+			static_assert(wrong_t<T>::value, "the SQL text of this expression is not known at compile time");
+		};
+
+	template<typename T, char... Cs>
+		struct static_sql_text_t<T, char_sequence<Cs...>>
+		{
+			static constexpr char _text[] = {Cs..., '\0'};
+			static constexpr std::size_t _size = sizeof...(Cs);
+		};
+
+	template<typename T, char... Cs>
+		constexpr char static_sql_text_t<T, char_sequence<Cs...>>::_text[];
+
+	template<typename T, char... Cs>
+		constexpr std::size_t static_sql_text_t<T, char_sequence<Cs...>>::_size;
+
+	// A serializer context opts in to static SQL text by declaring
+	//   using _use_static_sql = std::true_type;
+	// Connectors that specialize serializer_t for any node type (e.g. numbered
+	// parameters) must not opt in, since the static text uses the standard output.
+	template<typename Context, typename Enable = void>
+		struct uses_static_sql_t: std::false_type
+		{};
+
+	template<typename Context>
+		struct uses_static_sql_t<Context, typename std::enable_if<Context::_use_static_sql::value, void>::type>: std::true_type
+		{};
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include <sqlpp11/detail/type_set.h>
 #include <sqlpp11/join.h>
 #include <sqlpp11/no_value.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
@@ -113,6 +114,12 @@ namespace sqlpp
 			}
 		};
 
+	template<typename X>
+		struct static_sql_t<X, typename std::enable_if<std::is_base_of<table_base_t, X>::value and not is_pseudo_table_t<X>::value, void>::type>
+		{
+			using type = static_sql_name_of<X>;
+		};
+
 
 }
 
@@ -30,10 +30,12 @@
 #include <sqlpp11/basic_expression_operators.h>
 #include <sqlpp11/type_traits.h>
 #include <sqlpp11/exception.h>
+#include <sqlpp11/assignment.h>
 #include <sqlpp11/concat.h>
 #include <sqlpp11/like.h>
 #include <sqlpp11/result_field.h>
 #include <sqlpp11/char_sequence.h>
+#include <sqlpp11/text_view.h>
 
 namespace sqlpp
 {
@@ -115,6 +117,12 @@ namespace sqlpp
 					target._bind_text_parameter(index, &_value, _is_null);
 				}
 
+			template<typename Target>
+				void _bind_array(Target& target, size_t index, size_t stride, size_t count) const
+				{
+					target._bind_text_parameter_array(index, &_value, &_is_null, stride, count);
+				}
+
 		private:
 			_cpp_value_type _value;
 			bool _is_null;
@@ -189,7 +197,7 @@ namespace sqlpp
 			_len = 0;
 		}
 
-		bool operator==(const _cpp_value_type& rhs) const { return value() == rhs; }
+		bool operator==(const _cpp_value_type& rhs) const { return view() == rhs; }
 		bool operator!=(const _cpp_value_type& rhs) const { return not operator==(rhs); }
 
 		bool is_null() const
@@ -204,7 +212,7 @@ namespace sqlpp
 			if (not _is_valid)
 				throw exception("accessing is_null in non-existing row");
 
-			return value() == "";
+			return view().empty();
 		}
 
 		_cpp_value_type value() const
@@ -213,6 +221,12 @@ namespace sqlpp
 			return _cpp_value_type( val, val + _len);
 		}
 
+		// Refers to the connector's buffer, valid until the row is advanced
+		text_view_t view() const
+		{
+			return {data(), _len};
+		}
+
 		template<typename Target>
 			void _bind(Target& target, size_t i)
 			{
@@ -249,6 +263,30 @@ namespace sqlpp
 		size_t _len;
 	};
 
+	namespace detail
+	{
+		// Contexts like buffer_serializer_context_t escape characters in place,
+		// others get a std::string
+		template<typename Context>
+			auto serialize_escaped_text_impl(Context& context, const text_view_t& view, int)
+			-> decltype(context << context.escape(view.data(), view.size()), void())
+			{
+				context << context.escape(view.data(), view.size());
+			}
+
+		template<typename Context>
+			void serialize_escaped_text_impl(Context& context, const text_view_t& view, long)
+			{
+				context << context.escape(view.str());
+			}
+
+		template<typename Context>
+			void serialize_escaped_text(Context& context, const text_view_t& view)
+			{
+				serialize_escaped_text_impl(context, view, 0);
+			}
+	}
+
 	template<typename Context, typename Db, typename FieldSpec>
 		struct serializer_t<Context, result_field_t<text, Db, FieldSpec>>
 		{
@@ -263,7 +301,9 @@ namespace sqlpp
 				}
 				else
 				{
-					context << '\'' << context.escape(t.value()) << '\'';
+					context << '\'';
+					detail::serialize_escaped_text(context, t.view());
+					context << '\'';
 				}
 				return context;
 			}
@@ -278,7 +318,7 @@ namespace sqlpp
 			}
 			else
 			{
-				return os << e.value();
+				return os << e.view();
 			}
 		}
 
@@ -0,0 +1,161 @@
+/*
+ * text_view.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_TEXT_VIEW_H
+#define SQLPP_TEXT_VIEW_H
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace sqlpp
+{
+	// Non-owning reference to characters of a text value, e.g. a result field.
+	// It is valid as long as the referenced characters are, i.e. for result
+	// fields until the row is advanced.
+	struct text_view_t
+	{
+		text_view_t():
+			_data(""),
+			_len(0)
+		{}
+
+		text_view_t(const char* data, std::size_t len):
+			_data(data),
+			_len(len)
+		{}
+
+		text_view_t(const text_view_t&) = default;
+		text_view_t(text_view_t&&) = default;
+		text_view_t& operator=(const text_view_t&) = default;
+		text_view_t& operator=(text_view_t&&) = default;
+		~text_view_t() = default;
+
+		const char* data() const
+		{
+			return _data;
+		}
+
+		std::size_t size() const
+		{
+			return _len;
+		}
+
+		bool empty() const
+		{
+			return _len == 0;
+		}
+
+		const char* begin() const
+		{
+			return _data;
+		}
+
+		const char* end() const
+		{
+			return _data + _len;
+		}
+
+		std::string str() const
+		{
+			return std::string(_data, _len);
+		}
+
+		explicit operator std::string() const
+		{
+			return str();
+		}
+
+		bool _equals(const char* data, std::size_t len) const
+		{
+			return _len == len and (len == 0 or std::memcmp(_data, data, len) == 0);
+		}
+
+	private:
+		const char* _data;
+		std::size_t _len;
+	};
+
+	inline bool operator==(const text_view_t& lhs, const text_view_t& rhs)
+	{
+		return lhs._equals(rhs.data(), rhs.size());
+	}
+
+	inline bool operator==(const text_view_t& lhs, const std::string& rhs)
+	{
+		return lhs._equals(rhs.data(), rhs.size());
+	}
+
+	inline bool operator==(const std::string& lhs, const text_view_t& rhs)
+	{
+		return rhs == lhs;
+	}
+
+	inline bool operator==(const text_view_t& lhs, const char* rhs)
+	{
+		return lhs._equals(rhs, std::strlen(rhs));
+	}
+
+	inline bool operator==(const char* lhs, const text_view_t& rhs)
+	{
+		return rhs == lhs;
+	}
+
+	inline bool operator!=(const text_view_t& lhs, const text_view_t& rhs)
+	{
+		return not (lhs == rhs);
+	}
+
+	inline bool operator!=(const text_view_t& lhs, const std::string& rhs)
+	{
+		return not (lhs == rhs);
+	}
+
+	inline bool operator!=(const std::string& lhs, const text_view_t& rhs)
+	{
+		return not (lhs == rhs);
+	}
+
+	inline bool operator!=(const text_view_t& lhs, const char* rhs)
+	{
+		return not (lhs == rhs);
+	}
+
+	inline bool operator!=(const char* lhs, const text_view_t& rhs)
+	{
+		return not (lhs == rhs);
+	}
+
+	inline std::ostream& operator<<(std::ostream& os, const text_view_t& view)
+	{
+		return os.write(view.data(), static_cast<std::streamsize>(view.size()));
+	}
+}
+
+#endif
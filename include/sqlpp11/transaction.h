@@ -27,36 +27,175 @@
 #ifndef SQLPP_TRANSACTION_H
 #define SQLPP_TRANSACTION_H
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <sqlpp11/exception.h>
 
 namespace sqlpp
 {
 	static constexpr bool quiet_auto_rollback = false;
 	static constexpr bool report_auto_rollback = true;
 
+	namespace detail
+	{
+		// Connections handed out for a while, e.g. by connection_pool_t, specialize this to return a flag
+		// that is cleared when the connection is given back. Transactions and savepoints of an expired
+		// lease leave the connection alone: it has been cleaned up and may belong to someone else by now.
+		template<typename Db>
+			struct connection_lease_t
+			{
+				static std::shared_ptr<const std::atomic<bool>> get(const Db&)
+				{
+					return nullptr;
+				}
+			};
+	}
+
+	// A nested transaction within a transaction_t, mapped to SAVEPOINT, RELEASE and ROLLBACK TO.
+	// Rolling back a savepoint undoes the statements since its creation only, e.g. to retry a chunk:
+	//   auto tx = start_transaction(db);
+	//   for (const auto& chunk : chunks)
+	//   {
+	//     auto sp = tx.savepoint();
+	//     if (not try_chunk(db, chunk))
+	//       sp.rollback();
+	//     else
+	//       sp.release();
+	//   }
+	//   tx.commit();
+	// Like transaction_t, savepoints that are neither released nor rolled back are rolled back when destroyed.
+	template<typename Db>
+		class savepoint_t
+		{
+			Db& _db;
+			std::shared_ptr<const std::atomic<bool>> _lease;
+			// Shared with the transaction and the other savepoints, it outlives a moved transaction_t
+			std::shared_ptr<std::size_t> _savepoints;
+			const std::string _name;
+			const bool _report_unfinished_savepoint;
+			bool _finished = false;
+
+		public:
+			savepoint_t(Db& db, std::shared_ptr<const std::atomic<bool>> lease, std::shared_ptr<std::size_t> savepoints, bool report_unfinished_savepoint):
+				_db(db),
+				_lease(std::move(lease)),
+				_savepoints(std::move(savepoints)),
+				_name("sqlpp_savepoint_" + std::to_string(++*_savepoints)),
+				_report_unfinished_savepoint(report_unfinished_savepoint)
+			{
+				_db.savepoint(_name);
+			}
+
+			savepoint_t(const savepoint_t&) = delete;
+			savepoint_t(savepoint_t&& rhs):
+				_db(rhs._db),
+				_lease(rhs._lease),
+				_savepoints(rhs._savepoints),
+				_name(rhs._name),
+				_report_unfinished_savepoint(rhs._report_unfinished_savepoint),
+				_finished(rhs._finished)
+			{
+				rhs._finished = true;
+			}
+			savepoint_t& operator=(const savepoint_t&) = delete;
+			savepoint_t& operator=(savepoint_t&&) = delete;
+
+			~savepoint_t()
+			{
+				if (not _finished and _leased())
+				{
+					try
+					{
+						_db.rollback_to_savepoint(_name, _report_unfinished_savepoint);
+					}
+					catch(const std::exception& e)
+					{
+						_db.report_rollback_failure(std::string("auto rollback to savepoint failed: ") + e.what());
+					}
+					catch(...)
+					{
+						_db.report_rollback_failure("auto rollback to savepoint failed with unknown exception");
+					}
+				}
+			}
+
+			// Nested savepoints have to be finished before this one
+			savepoint_t savepoint(bool report_unfinished_savepoint = report_auto_rollback)
+			{
+				_check_lease();
+				return { _db, _lease, _savepoints, report_unfinished_savepoint };
+			}
+
+			const std::string& name() const
+			{
+				return _name;
+			}
+
+			void release()
+			{
+				_finished = true;
+				_check_lease();
+				_db.release_savepoint(_name);
+			}
+
+			void rollback()
+			{
+				_finished = true;
+				_check_lease();
+				_db.rollback_to_savepoint(_name, false);
+			}
+
+		private:
+			bool _leased() const
+			{
+				return not _lease or *_lease;
+			}
+
+			void _check_lease() const
+			{
+				if (not _leased())
+					throw exception("savepoint_t: the connection has been returned to its pool");
+			}
+		};
+
 	template<typename Db>
 		class transaction_t
 		{
 			Db& _db;
+			std::shared_ptr<const std::atomic<bool>> _lease;
 			const bool _report_unfinished_transaction;
 			bool _finished = false;
+			std::shared_ptr<std::size_t> _savepoints;
 
 		public:
 			transaction_t(Db& db, bool report_unfinished_transaction):
 				_db(db),
+				_lease(detail::connection_lease_t<Db>::get(db)),
 				_report_unfinished_transaction(report_unfinished_transaction)
 			{
 				_db.start_transaction();
 			}
 
 			transaction_t(const transaction_t&) = delete;
-			transaction_t(transaction_t&&) = default;
+			transaction_t(transaction_t&& rhs):
+				_db(rhs._db),
+				_lease(std::move(rhs._lease)),
+				_report_unfinished_transaction(rhs._report_unfinished_transaction),
+				_finished(rhs._finished),
+				_savepoints(std::move(rhs._savepoints))
+			{
+				rhs._finished = true;
+			}
 			transaction_t& operator=(const transaction_t&) = delete;
 			transaction_t& operator=(transaction_t&&) = delete;
 
 			~transaction_t()
 			{
-				if (not _finished)
+				if (not _finished and _leased())
 				{
 					try
 					{
@@ -73,17 +212,40 @@ namespace sqlpp
 				}
 			}
 
+			// Savepoints have to be finished before the transaction
+			savepoint_t<Db> savepoint(bool report_unfinished_savepoint = report_auto_rollback)
+			{
+				_check_lease();
+				if (not _savepoints)
+					_savepoints = std::make_shared<std::size_t>(0);
+				return { _db, _lease, _savepoints, report_unfinished_savepoint };
+			}
+
 			void commit()
 			{
 				_finished = true;
+				_check_lease();
 				_db.commit_transaction();
 			}
 
 			void rollback()
 			{
 				_finished = true;
+				_check_lease();
 				_db.rollback_transaction(false);
 			}
+
+		private:
+			bool _leased() const
+			{
+				return not _lease or *_lease;
+			}
+
+			void _check_lease() const
+			{
+				if (not _leased())
+					throw exception("transaction_t: the connection has been returned to its pool");
+			}
 		};
 
 	template<typename Db>
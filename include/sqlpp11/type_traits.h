@@ -175,6 +175,7 @@ namespace sqlpp
 	SQLPP_VALUE_TRAIT_GENERATOR(is_insert_list)
 	SQLPP_VALUE_TRAIT_GENERATOR(is_insert_value)
 	SQLPP_VALUE_TRAIT_GENERATOR(is_insert_value_list)
+	SQLPP_VALUE_TRAIT_GENERATOR(is_on_conflict)
 	SQLPP_VALUE_TRAIT_GENERATOR(is_sort_order)
 	SQLPP_VALUE_TRAIT_GENERATOR(is_parameter)
 
@@ -36,6 +36,7 @@
 #include <sqlpp11/update_list.h>
 #include <sqlpp11/noop.h>
 #include <sqlpp11/where.h>
+#include <sqlpp11/returning.h>
 
 namespace sqlpp
 {
@@ -75,14 +76,14 @@ namespace sqlpp
 					auto _prepare(Db& db, const Composite& composite) const
 					-> prepared_update_t<Db, Composite>
 					{
-						return {{}, db.prepare_update(composite)};
+						return {{}, {}, db.prepare_update(composite)};
 					}
 
 				template<typename Db>
 					auto _prepare(Db& db) const
 					-> prepared_update_t<Db, _statement_t>
 					{
-						return {{}, db.prepare_update(_get_statement())};
+						return {{}, _get_statement()._get_dynamic_parameters(), db.prepare_update(_get_statement())};
 					}
 			};
 	};
@@ -107,7 +108,8 @@ namespace sqlpp
 					update_t,
 					no_single_table_t,
 					no_update_list_t,
-					no_where_t<true>
+					no_where_t<true>,
+					no_returning_t
 						>;
 
 	template<typename Table>
@@ -231,6 +231,16 @@ namespace sqlpp
 			};
 	};
 
+	template<typename Database, typename... Assignments>
+		struct dynamic_parts_t<update_list_data_t<Database, Assignments...>>
+		{
+			template<typename Visitor>
+				static void _(const update_list_data_t<Database, Assignments...>& t, Visitor& visitor)
+				{
+					t._dynamic_assignments._visit(visitor);
+				}
+		};
+
 	// Interpreters
 	template<typename Context, typename Database, typename... Assignments>
 		struct serializer_t<Context, update_list_data_t<Database, Assignments...>>
@@ -196,6 +196,16 @@ namespace sqlpp
 			};
 	};
 
+	template<typename Database, typename... Tables>
+		struct dynamic_parts_t<using_data_t<Database, Tables...>>
+		{
+			template<typename Visitor>
+				static void _(const using_data_t<Database, Tables...>& t, Visitor& visitor)
+				{
+					t._dynamic_tables._visit(visitor);
+				}
+		};
+
 	// Interpreters
 	template<typename Context, typename Database, typename... Tables>
 		struct serializer_t<Context, using_data_t<Database, Tables...>>
@@ -34,6 +34,7 @@
 #include <sqlpp11/interpret_tuple.h>
 #include <sqlpp11/interpretable_list.h>
 #include <sqlpp11/logic.h>
+#include <sqlpp11/static_sql.h>
 
 namespace sqlpp
 {
@@ -279,6 +280,24 @@ namespace sqlpp
 				};
 		};
 
+	template<typename Database, typename... Expressions>
+		struct dynamic_parts_t<where_data_t<Database, Expressions...>>
+		{
+			template<typename Visitor>
+				static void _(const where_data_t<Database, Expressions...>& t, Visitor& visitor)
+				{
+					t._dynamic_expressions._visit(visitor);
+				}
+		};
+
+	template<>
+		struct dynamic_parts_t<where_data_t<void, bool>>
+		{
+			template<typename Visitor>
+				static void _(const where_data_t<void, bool>&, Visitor&)
+				{}
+		};
+
 	// Interpreters
 	template<typename Context, typename Database, typename... Expressions>
 		struct serializer_t<Context, where_data_t<Database, Expressions...>>
@@ -299,6 +318,23 @@ namespace sqlpp
 			}
 		};
 
+	template<typename Database, typename... Expressions>
+		struct static_part_of_t<where_data_t<Database, Expressions...>>
+		{
+			using type = where_data_t<void, Expressions...>;
+		};
+
+	template<typename... Expressions>
+		struct static_sql_t<where_data_t<void, Expressions...>>
+		{
+			static constexpr const char _literal[] = " WHERE ";
+			static constexpr const char _separator[] = " AND ";
+			using type = typename std::conditional<sizeof...(Expressions) == 0,
+						char_sequence<>,
+						static_sql_cat_t<make_static_sql_literal<sizeof(_literal), _literal>,
+							static_sql_join_t<make_static_sql_literal<sizeof(_separator), _separator>, static_sql_operand_of<Expressions>...>>>::type;
+		};
+
 	template<typename Context>
 		struct serializer_t<Context, where_data_t<void, bool>>
 		{
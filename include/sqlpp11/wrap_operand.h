@@ -32,6 +32,7 @@
 #include <sqlpp11/serializer.h>
 #include <sqlpp11/type_traits.h>
 #include <sqlpp11/basic_expression_operators.h>
+#include <sqlpp11/literal_bind_list.h>
 
 namespace sqlpp
 {
@@ -40,6 +41,17 @@ namespace sqlpp
 	struct floating_point;
 	struct text;
 
+	namespace detail
+	{
+		template<typename Operand, typename Context>
+			Context& serialize_parameterized_literal(const Operand& t, Context& context)
+			{
+				context << '?';
+				context._literals._add(t._t);
+				return context;
+			}
+	}
+
 	struct boolean_operand: public alias_operators<boolean_operand>
 	{
 		using _traits = make_traits<boolean, tag::is_expression, tag::is_wrapped_value>;
@@ -73,10 +85,22 @@ namespace sqlpp
 			using Operand = boolean_operand;
 
 			static Context& _(const Operand& t, Context& context)
+			{
+				return _impl(t, context, parameterizes_literals_t<Context>{});
+			}
+
+			static Context& _impl(const Operand& t, Context& context, const std::false_type&)
 			{
 				context << t._t;
 				return context;
 			}
+
+			static Context& _impl(const Operand& t, Context& context, const std::true_type&)
+			{
+				if (context._inline_literals)
+					return _impl(t, context, std::false_type{});
+				return detail::serialize_parameterized_literal(t, context);
+			}
 		};
 
 	struct integral_operand: public alias_operators<integral_operand>
@@ -112,10 +136,22 @@ namespace sqlpp
 			using Operand = integral_operand;
 
 			static Context& _(const Operand& t, Context& context)
+			{
+				return _impl(t, context, parameterizes_literals_t<Context>{});
+			}
+
+			static Context& _impl(const Operand& t, Context& context, const std::false_type&)
 			{
 				context << t._t;
 				return context;
 			}
+
+			static Context& _impl(const Operand& t, Context& context, const std::true_type&)
+			{
+				if (context._inline_literals)
+					return _impl(t, context, std::false_type{});
+				return detail::serialize_parameterized_literal(t, context);
+			}
 		};
 
 
@@ -152,10 +188,22 @@ namespace sqlpp
 			using Operand = floating_point_operand;
 
 			static Context& _(const Operand& t, Context& context)
+			{
+				return _impl(t, context, parameterizes_literals_t<Context>{});
+			}
+
+			static Context& _impl(const Operand& t, Context& context, const std::false_type&)
 			{
 				context << t._t;
 				return context;
 			}
+
+			static Context& _impl(const Operand& t, Context& context, const std::true_type&)
+			{
+				if (context._inline_literals)
+					return _impl(t, context, std::false_type{});
+				return detail::serialize_parameterized_literal(t, context);
+			}
 		};
 
 	struct text_operand: public alias_operators<text_operand>
@@ -191,10 +239,22 @@ namespace sqlpp
 			using Operand = text_operand;
 
 			static Context& _(const Operand& t, Context& context)
+			{
+				return _impl(t, context, parameterizes_literals_t<Context>{});
+			}
+
+			static Context& _impl(const Operand& t, Context& context, const std::false_type&)
 			{
 				context << '\'' << context.escape(t._t) << '\'';
 				return context;
 			}
+
+			static Context& _impl(const Operand& t, Context& context, const std::true_type&)
+			{
+				if (context._inline_literals)
+					return _impl(t, context, std::false_type{});
+				return detail::serialize_parameterized_literal(t, context);
+			}
 		};
 
 	template<typename T, typename Enable>
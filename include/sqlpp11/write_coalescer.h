@@ -0,0 +1,258 @@
+/*
+ * write_coalescer.h
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLPP_WRITE_COALESCER_H
+#define SQLPP_WRITE_COALESCER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sqlpp11/exception.h>
+#include <sqlpp11/serializer.h>
+#include <sqlpp11/buffer_serializer_context.h>
+#include <sqlpp11/transaction.h>
+
+namespace sqlpp
+{
+	struct write_coalescer_options_t
+	{
+		// A batch is committed when it has this many statements,
+		std::size_t max_statements = 1000;
+		// or this many bytes of serialized statements (zero disables the limit and the extra serialization),
+		std::size_t max_bytes = 0;
+		// or when its first statement has been waiting for this long
+		std::chrono::milliseconds max_delay = std::chrono::milliseconds(10);
+	};
+
+	// Runs small insert, update and remove statements of one or more threads in shared transactions,
+	// trading latency for fewer commits (and fsyncs):
+	//   write_coalescer_t<Db> writer(db, options);
+	//   auto written = writer.submit(insert_into(t).set(t.beta = "x", t.gamma = true));
+	//   written.get(); // committed
+	//
+	// The connection is used by the coalescer's worker thread exclusively. Futures are resolved with the
+	// result of running the statement once its transaction is committed, or with the exception that
+	// prevented this. A failing statement is rolled back with its batch, the other statements of the
+	// batch are then run again without it. Remaining statements are committed when the coalescer is destroyed.
+	template<typename Db>
+		class write_coalescer_t
+		{
+			using _clock_t = std::chrono::steady_clock;
+
+			struct _job_t
+			{
+				std::function<std::size_t(Db&)> _run;
+				std::promise<std::size_t> _promise;
+				std::size_t _bytes;
+				_clock_t::time_point _queued;
+			};
+
+		public:
+			write_coalescer_t(Db& db, const write_coalescer_options_t& options = {}):
+				_db(db),
+				_options(options)
+			{
+				if (options.max_statements == 0)
+					throw exception("write_coalescer_t requires max_statements greater than zero");
+				_worker = std::thread(&write_coalescer_t::_work, this);
+			}
+
+			write_coalescer_t(const write_coalescer_t&) = delete;
+			write_coalescer_t(write_coalescer_t&&) = delete;
+			write_coalescer_t& operator=(const write_coalescer_t&) = delete;
+			write_coalescer_t& operator=(write_coalescer_t&&) = delete;
+
+			~write_coalescer_t()
+			{
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_stopping = true;
+				}
+				_queued.notify_one();
+				_worker.join();
+			}
+
+			template<typename Statement>
+				std::future<std::size_t> submit(Statement statement)
+				{
+					static_assert(std::is_convertible<decltype(std::declval<Db&>()(statement)), std::size_t>::value, "write_coalescer_t::submit() requires an insert, update or remove statement");
+
+					_job_t job;
+					job._run = [statement](Db& db) -> std::size_t { return db(statement); };
+					job._bytes = 0;
+					if (_options.max_bytes)
+					{
+						buffer_serializer_context_t context;
+						serialize(statement, context);
+						job._bytes = context.size();
+					}
+					auto result = job._promise.get_future();
+					{
+						std::lock_guard<std::mutex> lock(_mutex);
+						if (_stopping)
+							throw exception("write_coalescer_t::submit() called during destruction");
+						job._queued = _clock_t::now();
+						_bytes += job._bytes;
+						_jobs.push_back(std::move(job));
+					}
+					_queued.notify_one();
+					return result;
+				}
+
+			// Commits the queued statements without waiting for a threshold.
+			// Does nothing if the queue is empty, statements submitted later are coalesced as usual.
+			void flush()
+			{
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (_jobs.empty())
+						return;
+					_flush = true;
+				}
+				_queued.notify_one();
+			}
+
+		private:
+			bool _full() const
+			{
+				return _jobs.size() >= _options.max_statements or (_options.max_bytes and _bytes >= _options.max_bytes);
+			}
+
+			void _work()
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				while (true)
+				{
+					_queued.wait(lock, [this]{ return _stopping or not _jobs.empty(); });
+					if (_jobs.empty())
+						return;
+					const auto deadline = _jobs.front()._queued + _options.max_delay;
+					_queued.wait_until(lock, deadline, [this]{ return _stopping or _flush or _full(); });
+					_flush = false;
+
+					std::vector<_job_t> batch;
+					std::size_t bytes = 0;
+					while (not _jobs.empty() and batch.size() < _options.max_statements
+							and (_options.max_bytes == 0 or bytes < _options.max_bytes))
+					{
+						bytes += _jobs.front()._bytes;
+						batch.push_back(std::move(_jobs.front()));
+						_jobs.pop_front();
+					}
+					_bytes -= bytes;
+
+					lock.unlock();
+					_commit(batch);
+					lock.lock();
+				}
+			}
+
+			void _commit(std::vector<_job_t>& batch)
+			{
+				std::vector<std::size_t> results;
+				while (not batch.empty())
+				{
+					results.clear();
+					std::exception_ptr error;
+					bool started = false;
+					try
+					{
+						auto transaction = start_transaction(_db);
+						started = true;
+						for (auto& job : batch)
+						{
+							try
+							{
+								results.push_back(job._run(_db));
+							}
+							catch (...)
+							{
+								error = std::current_exception();
+								break;
+							}
+						}
+						if (error)
+							transaction.rollback();
+						else
+							transaction.commit();
+					}
+					catch (...)
+					{
+						// begin, commit or rollback failed, nothing of the batch is known to be written.
+						// A failed commit leaves the transaction open, every later begin would fail.
+						const auto failure = std::current_exception();
+						if (started)
+						{
+							try
+							{
+								_db.rollback_transaction(false);
+							}
+							catch (...)
+							{
+							}
+						}
+						for (auto& job : batch)
+							job._promise.set_exception(failure);
+						return;
+					}
+
+					if (not error)
+					{
+						for (std::size_t i = 0; i < batch.size(); ++i)
+							batch[i]._promise.set_value(results[i]);
+						return;
+					}
+					const auto failed = batch.begin() + static_cast<std::ptrdiff_t>(results.size());
+					failed->_promise.set_exception(error);
+					batch.erase(failed);
+				}
+			}
+
+			Db& _db;
+			const write_coalescer_options_t _options;
+
+			std::mutex _mutex;
+			std::condition_variable _queued;
+			std::deque<_job_t> _jobs;
+			std::size_t _bytes = 0;
+			bool _flush = false;
+			bool _stopping = false;
+			std::thread _worker;
+		};
+}
+
+#endif
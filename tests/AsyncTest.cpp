@@ -0,0 +1,201 @@
+/*
+ * AsyncTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include "Check.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/async.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+namespace
+{
+	// Holds statements back until opened, so that tests can tell which ones are running
+	struct Gate
+	{
+		void pass()
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			++_entered;
+			_changed.notify_all();
+			_changed.wait(lock, [this] { return _open; });
+			++_passed;
+		}
+
+		void wait_for_entered(std::size_t entered)
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_changed.wait(lock, [this, entered] { return _entered >= entered; });
+		}
+
+		void open()
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_open = true;
+			_changed.notify_all();
+		}
+
+		std::size_t passed()
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _passed;
+		}
+
+		std::mutex _mutex;
+		std::condition_variable _changed;
+		bool _open = false;
+		std::size_t _entered = 0;
+		std::size_t _passed = 0;
+	};
+
+	struct GatedDb: public MockDb
+	{
+		GatedDb(Gate* gate):
+			_gate(gate)
+		{}
+
+		template<typename T>
+			auto operator()(const T& t) -> decltype(std::declval<MockDb&>()(t))
+			{
+				_gate->pass();
+				return MockDb::operator()(t);
+			}
+
+		Gate* _gate;
+	};
+
+
+	template<typename Handle>
+		bool throws(const std::string& what, Handle& handle)
+		{
+			try
+			{
+				handle.get();
+			}
+			catch (const sqlpp::exception&)
+			{
+				return true;
+			}
+			std::cerr << what << ": expected exception" << std::endl;
+			return false;
+		}
+}
+
+int main()
+{
+	test::TabBar t;
+	bool ok = true;
+
+	sqlpp::connection_pool_options_t single;
+	single.max_size = 1;
+	single.checkout_timeout = std::chrono::milliseconds(50);
+
+	// Bounded queue and cancellation
+	{
+		Gate gate;
+		sqlpp::connection_pool_t<GatedDb> pool(single, &gate);
+		sqlpp::async_options_t options;
+		options.workers = 1;
+		options.max_queue_depth = 2;
+		options.enqueue_timeout = std::chrono::milliseconds(50);
+		sqlpp::async_executor_t<GatedDb> async(pool, options);
+
+		auto running = async.db_async(insert_into(t).set(t.beta = "a", t.gamma = true));
+		gate.wait_for_entered(1);
+		auto cancelled = async.db_async(remove_from(t).where(t.beta == "a"));
+		auto queued = async.db_async(update(t).set(t.delta = 1).where(t.beta == "a"));
+		ok &= test::check<std::size_t>("queued", 2, async.queued());
+
+		try
+		{
+			async.db_async(remove_from(t).where(true));
+			std::cerr << "full queue: expected exception" << std::endl;
+			ok = false;
+		}
+		catch (const sqlpp::exception&)
+		{
+		}
+
+		ok &= test::check<bool>("cancel queued", true, cancelled.cancel());
+		ok &= test::check<bool>("cancel running", false, running.cancel());
+		ok &= throws("cancelled", cancelled);
+
+		gate.open();
+		ok &= test::check<std::size_t>("inserted", 0, running.get());
+		ok &= test::check<std::size_t>("updated", 0, queued.get());
+		ok &= test::check<std::size_t>("executed", 2, gate.passed());
+	}
+
+	// Rows keep their connection checked out
+	{
+		Gate gate;
+		gate.open();
+		sqlpp::connection_pool_t<GatedDb> pool(single, &gate);
+		sqlpp::async_executor_t<GatedDb> async(pool);
+		{
+			auto rows = async.db_async(select(t.alpha).from(t).where(true)).get();
+			ok &= test::check<bool>("rows", true, rows.empty());
+			auto blocked = async.db_async(remove_from(t).where(true));
+			ok &= throws("no connection", blocked);
+		}
+		ok &= test::check<std::size_t>("connection returned", 0, async.db_async(remove_from(t).where(true)).get());
+	}
+
+	// Prepared statements run with the parameters they were submitted with
+	{
+		Gate gate;
+		gate.open();
+		sqlpp::connection_pool_t<GatedDb> pool(single, &gate);
+		{
+			sqlpp::async_executor_t<GatedDb> async(pool);
+			auto prepared = async.prepare(insert_into(t).set(t.beta = parameter(t.beta), t.gamma = true));
+			prepared.params.beta = "a";
+			auto first = async.run_async(prepared);
+			prepared.params.beta = "b";
+			auto second = async.run_async(prepared);
+			first.get();
+			second.get();
+
+			auto removal = async.prepare(remove_from(t).where(t.beta == parameter(t.beta)));
+			removal.params.beta = "c";
+			async.run_async(removal).get();
+		}
+		auto db = pool.checkout();
+		ok &= test::check<std::string>("bound", "0:a 0:b 0:c ", db->_bind_log);
+		// Prepared once on the connection, which owns them
+		ok &= test::check<std::size_t>("prepared", 2, db->_statements.misses());
+		ok &= test::check<std::size_t>("reused", 1, db->_statements.hits());
+	}
+
+	return ok ? 0 : -1;
+}
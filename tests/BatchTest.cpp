@@ -0,0 +1,102 @@
+/*
+ * BatchTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+
+#include <iostream>
+
+namespace
+{
+	template<typename Prepared>
+		bool check(const Prepared& p, const std::string& expected)
+		{
+			if (p._prepared_statement._log != expected)
+			{
+				std::cerr << "expected: " << expected << "\nreceived: " << p._prepared_statement._log << std::endl;
+				return false;
+			}
+			return true;
+		}
+}
+
+int main()
+{
+	MockDb db;
+	test::TabBar t;
+
+	bool ok = true;
+
+	// One array bind per parameter, covering all rows
+	{
+		auto p = db.prepare(insert_into(t).set(t.beta = parameter(t.beta), t.gamma = parameter(t.gamma), t.delta = parameter(t.delta)));
+		decltype(p)::_batch_t rows(3);
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			rows[i].beta = "row" + std::to_string(i);
+			rows[i].gamma = (i % 2 == 0);
+			rows[i].delta = static_cast<int64_t>(i * 10);
+		}
+		rows[1].beta = nullptr;
+
+		if (db.run_batch(p, rows) != 3)
+		{
+			std::cerr << "expected three rows" << std::endl;
+			ok = false;
+		}
+		ok &= check(p, "0:row0,NULL,row2 1:1,0,1 2:0,10,20 ");
+	}
+
+	// Update, remove and floating point parameters
+	{
+		auto u = db.prepare(update(t).set(t.beta = parameter(t.beta)).where(t.alpha == parameter(t.alpha)));
+		decltype(u)::_batch_t rows(2);
+		rows[0].beta = "a";
+		rows[0].alpha = 1;
+		rows[1].beta = "b";
+		rows[1].alpha = 2;
+		db.run_batch(u, rows);
+		ok &= check(u, "0:a,b 1:1,2 ");
+
+		auto r = db.prepare(remove_from(t).where(t.alpha == parameter(sqlpp::floating_point(), t.alpha)));
+		decltype(r)::_batch_t removals(2);
+		removals[0].alpha = 0.5;
+		db.run_batch(r, removals);
+		ok &= check(r, "0:0.500000,NULL ");
+	}
+
+	// An empty batch binds nothing
+	{
+		auto p = db.prepare(insert_into(t).set(t.gamma = parameter(t.gamma)));
+		db.run_batch(p, decltype(p)::_batch_t{});
+		ok &= check(p, "");
+	}
+
+	return ok ? 0 : -1;
+}
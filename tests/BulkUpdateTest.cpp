@@ -0,0 +1,181 @@
+/*
+ * BulkUpdateTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sqlpp11/declare_table.h>
+#include <sqlpp11/integral.h>
+#include <sqlpp11/text.h>
+#include <sqlpp11/boolean.h>
+#include <sqlpp11/bulk_update.h>
+#include "MockDb.h"
+#include "Check.h"
+
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <tuple>
+#include <vector>
+
+SQLPP_DECLARE_TABLE(
+	(account),
+	(id     , integer, is_primary_key)
+	(name   , text   )
+	(active , boolean)
+	(score  , integer)
+);
+
+namespace
+{
+	// A dialect that joins against a VALUES list, as PostgreSQL does
+	struct FromValuesContext: MockDb::_serializer_context_t
+	{};
+
+	// ... and numbers its parameters
+	struct NumberingFromValuesContext: NumberingContext
+	{};
+}
+
+namespace sqlpp
+{
+	template<>
+		struct bulk_update_uses_from_values_t<FromValuesContext>: std::true_type
+		{};
+
+	template<>
+		struct bulk_update_uses_from_values_t<NumberingFromValuesContext>: std::true_type
+		{};
+
+	template<typename ValueType, typename NameType>
+		struct serializer_t<NumberingFromValuesContext, parameter_t<ValueType, NameType>>
+		{
+			using _serialize_check = consistent_t;
+			using T = parameter_t<ValueType, NameType>;
+
+			static NumberingFromValuesContext& _(const T& t, NumberingFromValuesContext& context)
+			{
+				serialize(t, static_cast<NumberingContext&>(context));
+				return context;
+			}
+		};
+}
+
+int main()
+{
+	MockDb db;
+	account a;
+	bool ok = true;
+
+	using statement_t = sqlpp::bulk_update_statement_t<decltype(a.id), decltype(a.name), decltype(a.active)>;
+
+	// The key is taken from the table definition
+	static_assert(std::is_same<sqlpp::bulk_update_t<MockDb, decltype(a.name)>::_key_t, decltype(a.id)>::value, "primary key expected");
+
+	// CASE form
+	{
+		MockDb::_serializer_context_t context;
+		serialize(statement_t{2}, context);
+		ok &= test::check<std::string>("case", "UPDATE account SET name=CASE id WHEN ? THEN ? WHEN ? THEN ? ELSE name END,"
+				"active=CASE id WHEN ? THEN ? WHEN ? THEN ? ELSE active END WHERE id IN (?,?)", context.str());
+
+		// Numbered placeholders follow the parameter indexes
+		NumberingContext numbering;
+		serialize(statement_t{2}, numbering);
+		ok &= test::check<std::string>("numbered case", "UPDATE account SET name=CASE id WHEN $1 THEN $2 WHEN $3 THEN $4 ELSE name END,"
+				"active=CASE id WHEN $5 THEN $6 WHEN $7 THEN $8 ELSE active END WHERE id IN ($9,$10)", numbering.str());
+		ok &= test::check<std::size_t>("case value", 5, statement_t::_value_index<NumberingContext>(2, 1, 0));
+	}
+
+	// Joined VALUES form
+	{
+		FromValuesContext context;
+		serialize(statement_t{2}, context);
+		ok &= test::check<std::string>("from values", "UPDATE account SET name=bulk_values.name,active=bulk_values.active "
+				"FROM (VALUES (?,?,?),(?,?,?)) AS bulk_values (id,name,active) WHERE account.id=bulk_values.id", context.str());
+		ok &= test::check<std::size_t>("from values key", 3, statement_t::_key_index<FromValuesContext>(2, 1, 1));
+		ok &= test::check<std::size_t>("from values value", 5, statement_t::_value_index<FromValuesContext>(2, 1, 1));
+
+		NumberingFromValuesContext numbering;
+		serialize(statement_t{2}, numbering);
+		ok &= test::check<std::string>("numbered from values", "UPDATE account SET name=bulk_values.name,active=bulk_values.active "
+				"FROM (VALUES ($1,$2,$3),($4,$5,$6)) AS bulk_values (id,name,active) WHERE account.id=bulk_values.id", numbering.str());
+	}
+
+	// Records are split into chunks and bound key first, in one transaction.
+	// With 5 parameters per record, chunks of 256 would exceed the default limit.
+	{
+		auto updater = sqlpp::bulk_update(db, a.name, a.active);
+		ok &= test::check<std::size_t>("chunk sizes", 3, updater.chunk_sizes().size());
+
+		const std::vector<std::tuple<int64_t, std::string, bool>> records = {
+			std::make_tuple(1, "one", true),
+			std::make_tuple(2, "two", false),
+		};
+		db._transaction_log.clear();
+		db._bind_log.clear();
+		updater.run(records);
+		ok &= test::check<std::string>("transactions", "begin;commit;", db._transaction_log);
+		ok &= test::check<std::string>("binds", "0:1 1:one 2:1 3:1 4:1 0:2 1:two 2:2 3:0 4:2 ", db._bind_log);
+	}
+
+	// Key and values are converted to the bound types, chunk sizes respect the parameter limit
+	{
+		sqlpp::bulk_update_t<MockDb, decltype(a.score)> updater(db, 100);
+		ok &= test::check<std::size_t>("limited chunk sizes", 2, updater.chunk_sizes().size());
+		ok &= test::check<std::size_t>("largest chunk", 8, updater.chunk_sizes().front());
+
+		std::list<std::tuple<int, short>> records;
+		for (int i = 0; i < 9; ++i)
+			records.emplace_back(i, static_cast<short>(10 * i));
+		db._bind_log.clear();
+		updater.run(records);
+		ok &= test::check<std::string>("converted", "0:8 1:80 2:8 ", db._bind_log.substr(db._bind_log.rfind("0:8 ")));
+		ok &= test::check<std::size_t>("empty", 0, updater.run(std::vector<std::tuple<int, short>>{}));
+	}
+
+	// Within a transaction or savepoint of the caller, records are updated under a savepoint instead
+	{
+		auto updater = sqlpp::bulk_update(db, a.name);
+		const std::vector<std::tuple<int64_t, std::string>> records = {std::make_tuple(1, "one")};
+
+		db._transaction_log.clear();
+		{
+			auto transaction = start_transaction(db);
+			updater.run(transaction, records);
+			auto savepoint = transaction.savepoint();
+			updater.run(savepoint, records);
+			savepoint.release();
+			transaction.commit();
+		}
+		ok &= test::check<std::string>("enclosing transactions", "begin;"
+				"savepoint sqlpp_savepoint_1;release sqlpp_savepoint_1;"
+				"savepoint sqlpp_savepoint_2;"
+				"savepoint sqlpp_savepoint_3;release sqlpp_savepoint_3;"
+				"release sqlpp_savepoint_2;commit;", db._transaction_log);
+	}
+
+	return ok ? 0 : -1;
+}
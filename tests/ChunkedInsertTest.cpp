@@ -0,0 +1,195 @@
+/*
+ * ChunkedInsertTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include "Check.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/chunked_insert.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Row
+	{
+		std::string beta;
+		bool gamma;
+		int delta;
+	};
+
+	// The binds MockDb logs for consecutive chunks, placeholders are numbered from 0 in each chunk
+	template<typename RowBinds>
+		std::string expected_binds(const std::vector<std::size_t>& chunks, const RowBinds& row_binds)
+		{
+			std::string binds;
+			std::size_t row = 0;
+			for (const auto chunk : chunks)
+			{
+				for (std::size_t offset = 0; offset < chunk; ++offset, ++row)
+					binds += row_binds(offset, row);
+			}
+			return binds;
+		}
+
+	// Only members that convert exactly to the bound type are accepted
+	using sqlpp::detail::is_range_member_compatible;
+	static_assert(is_range_member_compatible<sqlpp::integral, int64_t>::value, "");
+	static_assert(is_range_member_compatible<sqlpp::integral, uint32_t>::value, "");
+	static_assert(not is_range_member_compatible<sqlpp::integral, uint64_t>::value, "");
+	static_assert(not is_range_member_compatible<sqlpp::integral, bool>::value, "");
+	static_assert(is_range_member_compatible<sqlpp::floating_point, float>::value, "");
+	static_assert(is_range_member_compatible<sqlpp::floating_point, int32_t>::value, "");
+	static_assert(not is_range_member_compatible<sqlpp::floating_point, int64_t>::value, "");
+	static_assert(not is_range_member_compatible<sqlpp::floating_point, long double>::value, "");
+}
+
+int main()
+{
+	MockDb db;
+	test::TabBar t;
+
+	bool ok = true;
+
+	// Placeholder rows
+	{
+		auto multi_insert = insert_into(t).columns(t.beta, t.gamma);
+		multi_insert.values._data._placeholder_rows = 3;
+		MockDb::_serializer_context_t context;
+		serialize(multi_insert, context);
+		ok &= test::check<std::string>("placeholders", "INSERT  INTO tab_bar (beta,gamma) VALUES (?,?),(?,?),(?,?)", context.str());
+
+		NumberingContext numbering;
+		serialize(multi_insert, numbering);
+		ok &= test::check<std::string>("numbered placeholders", "INSERT  INTO tab_bar (beta,gamma) VALUES ($1,$2),($3,$4),($5,$6)", numbering.str());
+	}
+
+	// Rows are split greedily into chunks, all in one transaction
+	{
+		auto multi_insert = insert_into(t).columns(t.beta, t.gamma);
+		for (int i = 0; i < 75; ++i)
+			multi_insert.values.add(t.beta = "row" + std::to_string(i), t.gamma = (i % 2 == 0));
+
+		auto inserter = sqlpp::chunked_insert(db, multi_insert);
+		ok &= test::check<std::size_t>("chunk sizes", 4, inserter.chunk_sizes().size());
+
+		const auto binds = expected_binds({64, 8, 1, 1, 1}, [](std::size_t offset, std::size_t row)
+				{
+					return std::to_string(2 * offset) + ":row" + std::to_string(row) + ' '
+						+ std::to_string(2 * offset + 1) + ':' + (row % 2 == 0 ? '1' : '0') + ' ';
+				});
+
+		db._transaction_log.clear();
+		db._bind_log.clear();
+		ok &= test::check<std::size_t>("rows", 75, inserter.run(multi_insert));
+		ok &= test::check<std::string>("transactions", "begin;commit;", db._transaction_log);
+		ok &= test::check<std::string>("binds", binds, db._bind_log);
+
+		// Prepared statements are reused
+		db._bind_log.clear();
+		ok &= test::check<std::size_t>("rows", 75, inserter.run(multi_insert));
+		ok &= test::check<std::string>("reused binds", binds, db._bind_log);
+	}
+
+	// Chunk sizes respect the parameter limit
+	{
+		auto multi_insert = insert_into(t).columns(t.beta, t.gamma, t.delta);
+		auto inserter = sqlpp::chunked_insert(db, multi_insert, 100);
+		ok &= test::check<std::size_t>("limited chunk sizes", 2, inserter.chunk_sizes().size());
+		ok &= test::check<std::size_t>("largest chunk", 8, inserter.chunk_sizes().front());
+	}
+
+	// Rows with default values are inserted separately, NULL and trivial values are bound
+	{
+		auto multi_insert = insert_into(t).columns(t.beta, t.gamma);
+		multi_insert.values.add(t.beta = "a", t.gamma = true);
+		multi_insert.values.add(t.beta = sqlpp::default_value, t.gamma = false);
+		multi_insert.values.add(t.beta = sqlpp::null, t.gamma = true);
+		multi_insert.values.add(t.beta = sqlpp::tvin(std::string{}), t.gamma = false);
+		multi_insert.values.add(t.beta = "", t.gamma = true);
+		auto inserter = sqlpp::chunked_insert(db, multi_insert);
+		db._bind_log.clear();
+		ok &= test::check<std::size_t>("rows", 5, inserter.run(multi_insert));
+		// The default row is not prepared, it does not show up in the log
+		ok &= test::check<std::string>("default and null binds", "0:a 1:1 0:NULL 1:1 0:NULL 1:0 0: 1:1 ", db._bind_log);
+	}
+
+	// Ranges of structs are bound member by member
+	{
+		std::vector<Row> rows;
+		for (int i = 0; i < 10; ++i)
+			rows.push_back({"row" + std::to_string(i), i % 2 == 0, -1000 * i});
+
+		auto inserter = sqlpp::chunked_insert(db, insert_into(t).columns(t.beta, t.gamma, t.delta));
+		db._transaction_log.clear();
+		db._bind_log.clear();
+		ok &= test::check<std::size_t>("range rows", 10, inserter.from_range(rows, &Row::beta, &Row::gamma, &Row::delta));
+		ok &= test::check<std::string>("range transactions", "begin;commit;", db._transaction_log);
+
+		// int and bool members are converted, text is bound in place
+		const auto binds = expected_binds({8, 1, 1}, [&rows](std::size_t offset, std::size_t row)
+				{
+					return std::to_string(3 * offset) + ':' + rows[row].beta + ' '
+						+ std::to_string(3 * offset + 1) + ':' + (rows[row].gamma ? '1' : '0') + ' '
+						+ std::to_string(3 * offset + 2) + ':' + std::to_string(rows[row].delta) + ' ';
+				});
+		ok &= test::check<std::string>("range binds", binds, db._bind_log);
+		ok &= test::check<std::size_t>("empty range", 0, inserter.from_range(std::vector<Row>{}, &Row::beta, &Row::gamma, &Row::delta));
+	}
+
+	// Within a transaction or savepoint of the caller, rows are inserted under a savepoint instead
+	{
+		auto multi_insert = insert_into(t).columns(t.beta, t.gamma);
+		multi_insert.values.add(t.beta = "a", t.gamma = true);
+		const std::vector<Row> rows = {{"b", false, 0}};
+		auto inserter = sqlpp::chunked_insert(db, multi_insert);
+
+		db._transaction_log.clear();
+		{
+			auto transaction = start_transaction(db);
+			ok &= test::check<std::size_t>("rows in transaction", 1, inserter.run(transaction, multi_insert));
+			ok &= test::check<std::size_t>("range in transaction", 1, inserter.from_range(transaction, rows, &Row::beta, &Row::gamma));
+			auto savepoint = transaction.savepoint();
+			ok &= test::check<std::size_t>("rows in savepoint", 1, inserter.run(savepoint, multi_insert));
+			ok &= test::check<std::size_t>("range in savepoint", 1, inserter.from_range(savepoint, rows, &Row::beta, &Row::gamma));
+			savepoint.release();
+			transaction.commit();
+		}
+		ok &= test::check<std::string>("enclosing transactions", "begin;"
+				"savepoint sqlpp_savepoint_1;release sqlpp_savepoint_1;"
+				"savepoint sqlpp_savepoint_2;release sqlpp_savepoint_2;"
+				"savepoint sqlpp_savepoint_3;"
+				"savepoint sqlpp_savepoint_4;release sqlpp_savepoint_4;"
+				"savepoint sqlpp_savepoint_5;release sqlpp_savepoint_5;"
+				"release sqlpp_savepoint_3;commit;", db._transaction_log);
+	}
+
+	return ok ? 0 : -1;
+}
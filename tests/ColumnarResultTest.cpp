@@ -0,0 +1,169 @@
+/*
+ * ColumnarResultTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/columnar_result.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Produces rows 0 .. _rows-1 with alpha = i, beta = "row i" (NULL for 3), gamma = i % 2 and omega = i / 2.0
+	struct columnar_result_t
+	{
+		std::size_t _rows;
+		std::size_t _next;
+		std::size_t _bind_count;
+		std::vector<std::string> _texts;
+
+		int64_t* _alpha;
+		const char** _beta;
+		std::size_t* _beta_lengths;
+		uint8_t* _beta_nulls;
+		signed char* _gamma;
+		double* _omega;
+
+		template<typename Batch>
+			void next_batch(Batch& batch)
+			{
+				if (_bind_count == 0)
+					batch._bind(*this);
+				++_bind_count;
+
+				std::size_t size = 0;
+				for (; size < batch.capacity() and _next < _rows; ++size, ++_next)
+				{
+					const auto i = _next;
+					_alpha[size] = static_cast<int64_t>(i);
+					if (i == 3)
+					{
+						_beta_nulls[size / 8] |= static_cast<uint8_t>(1u << (size % 8));
+					}
+					else
+					{
+						_beta[size] = _texts[i].data();
+						_beta_lengths[size] = _texts[i].size();
+					}
+					_gamma[size] = static_cast<signed char>(i % 2);
+					_omega[size] = static_cast<double>(i) / 2.0;
+				}
+				batch._set_size(size);
+			}
+
+		void _bind_boolean_column(size_t, signed char* values, uint8_t*, size_t)
+		{
+			_gamma = values;
+		}
+
+		void _bind_floating_point_column(size_t, double* values, uint8_t*, size_t)
+		{
+			_omega = values;
+		}
+
+		void _bind_integral_column(size_t, int64_t* values, uint8_t*, size_t)
+		{
+			_alpha = values;
+		}
+
+		void _bind_text_column(size_t, const char** values, size_t* lengths, uint8_t* null_bitmap, size_t)
+		{
+			_beta = values;
+			_beta_lengths = lengths;
+			_beta_nulls = null_bitmap;
+		}
+	};
+
+	struct ColumnarDb: public MockDb
+	{
+		template<typename Select>
+			columnar_result_t select(const Select&)
+			{
+				columnar_result_t result{5, 0, 0, {}, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+				for (std::size_t i = 0; i < result._rows; ++i)
+					result._texts.push_back("row " + std::to_string(i));
+				return result;
+			}
+	};
+}
+
+int main()
+{
+	ColumnarDb db;
+	test::TabBar t;
+	test::TabFoo f;
+
+	bool ok = true;
+	auto result = sqlpp::select_columnar(db, select(t.alpha, t.beta, t.gamma, f.omega).from(t, f).where(true), 2);
+
+	std::vector<std::size_t> batchSizes;
+	std::size_t row = 0;
+	while (result.next_batch())
+	{
+		const auto& batch = result.batch();
+		batchSizes.push_back(batch.size());
+
+		// struct of arrays
+		for (std::size_t i = 0; i < batch.size(); ++i)
+		{
+			const auto expected = row + i;
+			if (batch.alpha[i] != static_cast<int64_t>(expected) or batch.gamma[i] != (expected % 2 == 1) or batch.omega[i] != static_cast<double>(expected) / 2.0)
+			{
+				std::cerr << "unexpected values in row " << expected << std::endl;
+				ok = false;
+			}
+			if (batch.beta.is_null(i) != (expected == 3) or (expected != 3 and batch.beta[i] != "row " + std::to_string(expected)))
+			{
+				std::cerr << "unexpected text in row " << expected << std::endl;
+				ok = false;
+			}
+		}
+
+		// row views
+		for (const auto& r : batch)
+		{
+			if (r.alpha != static_cast<int64_t>(row) or r.beta.is_null() != (row == 3) or r.omega.value() != static_cast<double>(row) / 2.0)
+			{
+				std::cerr << "unexpected row view " << row << std::endl;
+				ok = false;
+			}
+			++row;
+		}
+	}
+
+	if (batchSizes != std::vector<std::size_t>{2, 2, 1} or row != 5)
+	{
+		std::cerr << "unexpected batch sizes" << std::endl;
+		ok = false;
+	}
+
+	return ok ? 0 : -1;
+}
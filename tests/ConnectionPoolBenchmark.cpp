@@ -0,0 +1,113 @@
+/*
+ * ConnectionPoolBenchmark.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sqlpp11/connection.h>
+#include <sqlpp11/connection_pool.h>
+#include <sqlpp11/transaction.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Checkouts per second under contention, with and without thread affinity, and the share of
+// checkouts that got the connection the thread used before
+namespace
+{
+	// Stand-in connector, a statement takes a few hundred nanoseconds
+	struct BenchDb: public sqlpp::connection
+	{
+		std::thread::id _last_user;
+		std::size_t _statements = 0;
+
+		void start_transaction() {}
+		void commit_transaction() {}
+		void rollback_transaction(bool) {}
+		void report_rollback_failure(const std::string&) {}
+
+		bool run()
+		{
+			const auto start = std::chrono::steady_clock::now();
+			while (std::chrono::steady_clock::now() - start < std::chrono::nanoseconds(300))
+			{}
+			++_statements;
+			const bool same = _last_user == std::this_thread::get_id();
+			_last_user = std::this_thread::get_id();
+			return same;
+		}
+	};
+
+	void run(std::size_t threads, bool affinity, std::size_t checkouts)
+	{
+		sqlpp::connection_pool_options_t options;
+		options.max_size = threads;
+		options.thread_affinity = affinity;
+		sqlpp::connection_pool_t<BenchDb> pool(options);
+
+		std::atomic<std::size_t> warm{0};
+		std::vector<std::thread> workers;
+		const auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < threads; ++i)
+		{
+			workers.emplace_back([&pool, &warm, checkouts]{
+					std::size_t same = 0;
+					for (std::size_t c = 0; c < checkouts; ++c)
+					{
+						auto db = pool.checkout();
+						auto tx = sqlpp::start_transaction(*db);
+						same += db->run() ? 1 : 0;
+						tx.commit();
+					}
+					warm += same;
+					});
+		}
+		for (auto& worker : workers)
+			worker.join();
+		const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		const auto total = static_cast<double>(threads * checkouts);
+
+		std::cout << threads << " threads, affinity " << (affinity ? "on:  " : "off: ")
+			<< total / seconds << " checkouts/s, "
+			<< 100.0 * static_cast<double>(warm.load()) / total << "% same connection, "
+			<< pool.size() << " connections" << std::endl;
+	}
+}
+
+int main()
+{
+	const std::size_t hardware = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4;
+	for (const std::size_t threads : {std::size_t{1}, std::size_t{4}, 2 * hardware})
+	{
+		run(threads, false, 20000);
+		run(threads, true, 20000);
+	}
+	return 0;
+}
@@ -0,0 +1,225 @@
+/*
+ * ConnectionPoolTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include "Check.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/connection_pool.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+	// Fails like a COMMIT running into a lock timeout
+	struct FailingCommitDb: public MockDb
+	{
+		void commit_transaction()
+		{
+			_transaction_log += "commit;";
+			throw sqlpp::exception("lock wait timeout exceeded");
+		}
+	};
+
+	// A connector that cannot tell whether a transaction is open
+	struct UnqueryableDb: public MockDb
+	{
+		bool is_transaction_active() const = delete;
+	};
+
+	// Code that knows nothing about pools
+	void begin(MockDb& db)
+	{
+		db.start_transaction();
+	}
+}
+
+int main()
+{
+	test::TabBar t;
+	bool ok = true;
+
+	sqlpp::connection_pool_options_t options;
+	options.max_size = 2;
+	options.checkout_timeout = std::chrono::milliseconds(20);
+
+	// Connections are created on demand and reused by the same thread
+	{
+		sqlpp::connection_pool_t<MockDb> pool(options);
+		const MockDb* first = nullptr;
+		{
+			auto db = pool.checkout();
+			(*db)(select(t.alpha).from(t).where(true));
+			first = &*db;
+		}
+		auto other = pool.checkout();
+		ok &= test::check<bool>("reused", true, &*other == first);
+		ok &= test::check<std::size_t>("size", 1, pool.size());
+
+		// The pool is exhausted until a connection is returned
+		auto second = pool.checkout();
+		ok &= test::check<std::size_t>("max size", 2, pool.size());
+		try
+		{
+			pool.checkout();
+			std::cerr << "exhausted: expected exception" << std::endl;
+			ok = false;
+		}
+		catch (const sqlpp::exception&)
+		{
+		}
+
+		other.discard();
+		ok &= test::check<std::size_t>("discarded", 1, pool.size());
+	}
+
+	// Checkouts wait for returned connections
+	{
+		auto waiting = options;
+		waiting.max_size = 1;
+		waiting.checkout_timeout = std::chrono::seconds(10);
+		sqlpp::connection_pool_t<MockDb> pool(waiting);
+		auto first = pool.checkout();
+		std::thread returner([&first]{
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+				first.release();
+				});
+		auto waited = pool.checkout();
+		returner.join();
+		ok &= test::check<bool>("waited", true, static_cast<bool>(waited));
+	}
+
+	// Transactions left open are rolled back on return, finished ones are not
+	{
+		sqlpp::connection_pool_t<MockDb> pool(options);
+		{
+			auto db = pool.checkout();
+			auto tx = start_transaction(*db);
+			tx.commit();
+			db->start_transaction();
+		}
+		auto db = pool.checkout();
+		ok &= test::check<std::string>("rollback", "begin;commit;begin;rollback;", db->_transaction_log);
+	}
+
+	// Transactions started via a plain connection reference are rolled back, too
+	{
+		sqlpp::connection_pool_t<MockDb> pool(options);
+		{
+			auto db = pool.checkout();
+			begin(*db);
+		}
+		auto db = pool.checkout();
+		ok &= test::check<std::string>("plain reference", "begin;rollback;", db->_transaction_log);
+	}
+
+	// Connectors that cannot tell get a rollback in any case
+	{
+		sqlpp::connection_pool_t<UnqueryableDb> pool(options);
+		pool.checkout();
+		auto db = pool.checkout();
+		ok &= test::check<std::string>("unqueryable", "rollback;", db->_transaction_log);
+	}
+
+	// Transactions outliving their checkout leave the connection alone
+	{
+		auto single = options;
+		single.max_size = 1;
+		sqlpp::connection_pool_t<MockDb> pool(single);
+		auto first = pool.checkout();
+		auto stale = start_transaction(*first);
+		auto stale_savepoint = stale.savepoint();
+		first.release();
+
+		auto second = pool.checkout();
+		second->start_transaction();
+		try
+		{
+			stale.commit();
+			std::cerr << "stale commit: expected exception" << std::endl;
+			ok = false;
+		}
+		catch (const sqlpp::exception&)
+		{
+		}
+		{
+			auto gone = std::move(stale_savepoint);
+		}
+		ok &= test::check<std::string>("stale", "begin;savepoint sqlpp_savepoint_1;rollback;begin;", second->_transaction_log);
+		second->commit_transaction();
+	}
+
+	// A failed commit leaves the transaction open, it is rolled back on return
+	{
+		sqlpp::connection_pool_t<FailingCommitDb> pool(options);
+		{
+			auto db = pool.checkout();
+			auto tx = start_transaction(*db);
+			try
+			{
+				tx.commit();
+				std::cerr << "failed commit: expected exception" << std::endl;
+				ok = false;
+			}
+			catch (const sqlpp::exception&)
+			{
+			}
+		}
+		auto db = pool.checkout();
+		ok &= test::check<std::string>("failed commit", "begin;commit;rollback;", db->_transaction_log);
+	}
+
+	// Connections failing validation are replaced
+	{
+		sqlpp::connection_pool_t<MockDb> pool(options);
+		pool.set_validator([](MockDb& db) { return db._transaction_log.empty(); });
+		{
+			auto db = pool.checkout();
+			db->start_transaction();
+			db->commit_transaction();
+		}
+		auto db = pool.checkout();
+		ok &= test::check<std::string>("validated", "", db->_transaction_log);
+		ok &= test::check<std::size_t>("replaced", 1, pool.size());
+	}
+
+	// Idle connections are evicted
+	{
+		options.max_idle = std::chrono::milliseconds(1);
+		sqlpp::connection_pool_t<MockDb> pool(options);
+		pool.checkout();
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		pool.evict_idle();
+		ok &= test::check<std::size_t>("evicted", 0, pool.size());
+	}
+
+	return ok ? 0 : -1;
+}
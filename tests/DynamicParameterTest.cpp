@@ -0,0 +1,139 @@
+/*
+ * DynamicParameterTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+
+#include <iostream>
+
+namespace
+{
+	template<typename Prepared>
+		bool check(const Prepared& p, const std::string& expected)
+		{
+			if (p._prepared_statement._log != expected)
+			{
+				std::cerr << "expected: " << expected << "\nreceived: " << p._prepared_statement._log << std::endl;
+				return false;
+			}
+			return true;
+		}
+
+	template<typename Function>
+		bool throws(const Function& function)
+		{
+			try
+			{
+				function();
+			}
+			catch (const sqlpp::exception&)
+			{
+				return true;
+			}
+			std::cerr << "expected an exception" << std::endl;
+			return false;
+		}
+}
+
+int main()
+{
+	MockDb db;
+	test::TabBar t;
+
+	bool ok = true;
+
+	// Placeholders are numbered in statement order: static and dynamic parameters interleave
+	{
+		auto s = dynamic_select(db, t.alpha).from(t)
+			.dynamic_where(t.alpha > parameter(t.alpha))
+			.dynamic_group_by(t.alpha)
+			.dynamic_having(max(t.delta) < parameter(t.delta));
+		s.where.add(t.beta == parameter(t.beta));
+		s.having.add(count(t.delta) > parameter(sqlpp::integral(), sqlpp::alias::a));
+
+		if (s._get_no_of_parameters() != 4)
+		{
+			std::cerr << "expected four parameters, got " << s._get_no_of_parameters() << std::endl;
+			ok = false;
+		}
+
+		auto p = db.prepare(s);
+		p.params.alpha = 7;
+		p.params.delta = 3;
+		p.dynamic_params.set("beta", "cheese");
+		p.dynamic_params.set("a", 2);
+		p._bind_params();
+		ok &= check(p, "0:7 2:3 1:cheese 3:2 ");
+
+		p._prepared_statement._log.clear();
+		p.dynamic_params.set_null("beta");
+		p._bind_params();
+		ok &= check(p, "0:7 2:3 1:NULL 3:2 ");
+
+		ok &= throws([&p](){ p.dynamic_params.set("gamma", true); });
+		ok &= throws([&p](){ p.dynamic_params.set("beta", 17); });
+	}
+
+	// Statements with dynamic parameters cannot be run directly
+	{
+		auto s = dynamic_select(db, t.alpha).from(t).dynamic_where();
+		s.where.add(t.beta == parameter(t.beta));
+		ok &= throws([&db, &s](){ db(s); });
+	}
+
+	// Static statements are bound as before
+	{
+		auto p = db.prepare(select(t.alpha).from(t).where(t.alpha == parameter(t.alpha)));
+		p.params.alpha = 1;
+		p._bind_params();
+		ok &= check(p, "0:1 ");
+		if (not p.dynamic_params.empty())
+		{
+			std::cerr << "expected no dynamic parameters" << std::endl;
+			ok = false;
+		}
+	}
+
+	// Dynamic values are shared by all rows of a batch
+	{
+		auto u = dynamic_update(db, t).dynamic_set(t.gamma = parameter(t.gamma)).dynamic_where(t.alpha == parameter(t.alpha));
+		u.assignments.add(t.delta = parameter(t.delta));
+		auto p = db.prepare(u);
+		p.dynamic_params.set("delta", 5);
+		decltype(p)::_batch_t rows(2);
+		rows[0].gamma = true;
+		rows[0].alpha = 1;
+		rows[1].gamma = false;
+		rows[1].alpha = 2;
+		db.run_batch(p, rows);
+		ok &= check(p, "0:1,0 2:1,2 1:5,5 ");
+	}
+
+	return ok ? 0 : -1;
+}
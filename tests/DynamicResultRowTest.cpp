@@ -0,0 +1,143 @@
+/*
+ * DynamicResultRowTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// One row, the static column is 17, dynamic column i holds "value i"
+	struct dynamic_result_t
+	{
+		std::vector<std::string>* _texts;
+		bool _done;
+
+		template<typename ResultRow>
+			void next(ResultRow& result_row)
+			{
+				if (_done)
+				{
+					result_row._invalidate();
+					return;
+				}
+				result_row._validate();
+				result_row._bind(*this);
+				_done = true;
+			}
+
+		void _bind_integral_result(size_t, int64_t* value, bool* is_null)
+		{
+			*value = 17;
+			*is_null = false;
+		}
+
+		void _bind_text_result(size_t index, const char** value, size_t* len)
+		{
+			// index 0 is the static column
+			const auto& text = (*_texts)[index - 1];
+			*value = text.data();
+			*len = text.size();
+		}
+
+		bool operator==(const dynamic_result_t& rhs) const
+		{
+			return _done == rhs._done;
+		}
+	};
+
+	struct DynamicDb: public MockDb
+	{
+		std::vector<std::string> _texts;
+
+		template<typename T>
+			auto operator() (const T& t) -> decltype(t._run(*this))
+			{
+				return t._run(*this);
+			}
+
+		template<typename Select>
+			dynamic_result_t select(const Select&)
+			{
+				return {&_texts, false};
+			}
+	};
+}
+
+int main()
+{
+	DynamicDb db;
+	test::TabBar t;
+	test::TabFoo f;
+
+	db._texts = {"value 0", "value 1", "value 2"};
+
+	bool ok = true;
+	auto s = dynamic_select(db).dynamic_columns(t.alpha).from(t, f).where(true);
+	s.selected_columns.add(t.beta);
+	s.selected_columns.add(f.delta);
+	s.selected_columns.add(t.gamma.as(f.omega));
+
+	{
+		auto result = db(s);
+		const auto& row = result.front();
+		const auto beta = row.handle("beta");
+		const auto omega = row.handle("omega");
+
+		if (row.alpha != 17 or row.at("beta") != "value 0" or row.at("delta") != "value 1" or row[omega] != "value 2" or row[beta] != "value 0")
+		{
+			std::cerr << "unexpected dynamic fields" << std::endl;
+			ok = false;
+		}
+
+		try
+		{
+			row.handle("gamma");
+			std::cerr << "expected an exception for an unknown field" << std::endl;
+			ok = false;
+		}
+		catch (const std::out_of_range&)
+		{
+		}
+
+		// Adding columns to the statement does not affect rows of earlier executions
+		s.selected_columns.add(t.delta);
+		if (row._dynamic_field_names.size() != 3 or s.get_dynamic_names().size() != 4)
+		{
+			std::cerr << "names are expected to be copied on write" << std::endl;
+			ok = false;
+		}
+	}
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,129 @@
+/*
+ * DynamicStatementBenchmark.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// Allocations and time per add() when assembling dynamic statements, and per
+// serialization of the result
+namespace
+{
+	std::size_t allocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+	++allocations;
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace
+{
+	template<typename Assemble>
+		void run(const std::string& name, std::size_t adds, std::size_t iterations, Assemble assemble)
+		{
+			MockDb db;
+			std::size_t assembleAllocations = 0;
+			std::size_t serializeAllocations = 0;
+			double assembleTime = 0;
+			double serializeTime = 0;
+			std::size_t size = 0;
+			MockDb::_serializer_context_t context;
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				auto before = allocations;
+				auto start = std::chrono::steady_clock::now();
+				const auto s = assemble(db, adds);
+				assembleTime += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+				assembleAllocations += allocations - before;
+
+				context.reset();
+				before = allocations;
+				start = std::chrono::steady_clock::now();
+				serialize(s, context);
+				serializeTime += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+				serializeAllocations += allocations - before;
+				size += context.size();
+			}
+			const auto total = static_cast<double>(adds * iterations);
+			std::cout << name << " (" << adds << " adds): "
+				<< assembleTime / total << " ns/add, " << static_cast<double>(assembleAllocations) / total << " allocations/add, "
+				<< serializeTime / total << " ns/entry serialized, " << static_cast<double>(serializeAllocations) / total << " allocations/entry serialized"
+				<< " (" << size << " bytes)" << std::endl;
+		}
+}
+
+int main()
+{
+	const test::TabBar t;
+	const test::TabFoo f;
+
+	for (const std::size_t adds : {4u, 32u})
+	{
+		run("where    ", adds, 20000, [&](MockDb& db, std::size_t n)
+				{
+					auto s = dynamic_select(db, t.alpha).from(t).dynamic_where();
+					for (std::size_t i = 0; i < n; ++i)
+						s.where.add(t.alpha != static_cast<int64_t>(i));
+					return s;
+				});
+
+		run("columns  ", adds, 20000, [&](MockDb& db, std::size_t n)
+				{
+					auto s = dynamic_select(db).dynamic_columns(t.alpha).from(t, f).where(true);
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						if (i % 2)
+							s.selected_columns.add(f.omega);
+						else
+							s.selected_columns.add(f.epsilon);
+					}
+					return s;
+				});
+	}
+
+	return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * InsertSelectTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include "Check.h"
+#include <sqlpp11/sqlpp11.h>
+
+#include <iostream>
+
+namespace
+{
+	template<typename T>
+		std::string to_sql(const T& t)
+		{
+			MockDb::_serializer_context_t context;
+			serialize(t, context);
+			return context.str();
+		}
+
+	template<typename Select, typename... Columns>
+		using compatible = sqlpp::detail::is_insert_select_compatible<Select, sqlpp::detail::type_vector<Columns...>>;
+}
+
+int main()
+{
+	MockDb db;
+	test::TabBar t;
+	test::TabFoo f;
+
+	bool ok = true;
+
+	// Serialization
+	{
+		auto i = insert_into(f).columns(f.delta, f.epsilon).select(select(t.beta, t.alpha).from(t).where(t.gamma == true));
+		ok &= test::check<std::string>("insert select", "INSERT  INTO tab_foo (delta,epsilon) SELECT tab_bar.beta,tab_bar.alpha FROM tab_bar WHERE (tab_bar.gamma=1)", to_sql(i));
+		db(i);
+
+		auto u = insert_into(f).columns(f.epsilon).select(select(t.alpha).from(t).where(true)).on_conflict(f.epsilon).do_nothing();
+		ok &= test::check<std::string>("with on_conflict", "INSERT  INTO tab_foo (epsilon) SELECT tab_bar.alpha FROM tab_bar ON CONFLICT (epsilon) DO NOTHING", to_sql(u));
+	}
+
+	// Column compatibility is checked at compile time
+	{
+		using S = decltype(select(t.beta, t.alpha).from(t).where(true));
+		using F = decltype(f);
+		static_assert(compatible<S, decltype(F::delta), decltype(F::epsilon)>::value, "text and integral");
+		static_assert(compatible<S, decltype(F::delta), decltype(F::omega)>::value, "integral into floating point");
+		static_assert(not compatible<S, decltype(F::epsilon), decltype(F::delta)>::value, "swapped columns");
+		static_assert(not compatible<S, decltype(F::delta)>::value, "too few columns");
+		static_assert(not compatible<decltype(select(t.beta, t.alpha)), decltype(F::delta), decltype(F::epsilon)>::value, "incomplete select");
+		static_assert(not compatible<decltype(insert_into(t).default_values()), decltype(F::delta)>::value, "not a select");
+
+		using foreign_select = decltype(insert_into(f).columns(f.epsilon).select(select(t.alpha).from(t).where(f.epsilon == 1)));
+		static_assert(not sqlpp::prepare_check_t<foreign_select>::type::value, "the select has to be consistent on its own");
+	}
+
+	// Parameters inside the select are bound when prepared
+	{
+		auto p = db.prepare(insert_into(f).columns(f.delta, f.epsilon).select(select(t.beta, t.alpha).from(t).where(t.alpha > parameter(t.alpha) and t.beta == parameter(t.beta))));
+		p.params.alpha = 7;
+		p.params.beta = "cheese";
+		p._bind_params();
+		ok &= test::check<std::string>("prepared", "0:7 1:cheese ", p._prepared_statement._log);
+	}
+
+	return ok ? 0 : -1;
+}
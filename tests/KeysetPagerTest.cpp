@@ -0,0 +1,189 @@
+/*
+ * KeysetPagerTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include "Check.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/keyset_pager.h>
+
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+	using row_t = std::tuple<int64_t, std::string, int64_t>;
+
+	// Yields the rows of one page, alpha, beta and delta
+	struct page_result_t
+	{
+		std::vector<row_t> _rows;
+		std::size_t _next;
+
+		template<typename ResultRow>
+			void next(ResultRow& result_row)
+			{
+				if (_next == _rows.size())
+				{
+					result_row._invalidate();
+					return;
+				}
+				result_row._validate();
+				result_row._bind(*this);
+				++_next;
+			}
+
+		void _bind_integral_result(size_t index, int64_t* value, bool* is_null)
+		{
+			*value = index == 0 ? std::get<0>(_rows[_next]) : std::get<2>(_rows[_next]);
+			*is_null = false;
+		}
+
+		void _bind_text_result(size_t, const char** value, size_t* len)
+		{
+			*value = std::get<1>(_rows[_next]).data();
+			*len = std::get<1>(_rows[_next]).size();
+		}
+
+		void _bind_boolean_result(size_t, signed char*, bool*) {}
+		void _bind_floating_point_result(size_t, double*, bool*) {}
+	};
+
+	// Serves pages in order and logs the statements and the parameters bound when running them
+	struct PagingDb: public MockDb
+	{
+		std::vector<std::vector<row_t>> _pages;
+		std::vector<std::string> _statements;
+
+		template<typename T>
+			auto prepare(const T& t) -> decltype(t._prepare(*this))
+			{
+				return t._prepare(*this);
+			}
+
+		template<typename T>
+			auto operator() (const T& t) -> decltype(t._run(*this))
+			{
+				return t._run(*this);
+			}
+
+		template<typename Select>
+			_prepared_statement_t prepare_select(Select& x)
+			{
+				_serializer_context_t context;
+				::sqlpp::serialize(x, context);
+				_statements.push_back(context.str());
+				return nullptr;
+			}
+
+		template<typename PreparedSelect>
+			page_result_t run_prepared_select(PreparedSelect& p)
+			{
+				p._bind_params();
+				_bind_log += p._prepared_statement._log;
+				p._prepared_statement._log.clear();
+				page_result_t result{_pages.empty() ? std::vector<row_t>{} : _pages.front(), 0};
+				if (not _pages.empty())
+					_pages.erase(_pages.begin());
+				return result;
+			}
+	};
+}
+
+int main()
+{
+	PagingDb db;
+	test::TabBar t;
+	bool ok = true;
+
+	// Mixed directions are expanded, the seek predicate is added to the existing condition
+	{
+		auto pager = sqlpp::keyset_pager(db, select(t.alpha, t.beta, t.delta).from(t).where(t.gamma == true).order_by(t.beta.asc(), t.alpha.desc()), 2);
+		ok &= test::check<std::size_t>("statements", 2, db._statements.size());
+		ok &= test::check<std::string>("first", "SELECT tab_bar.alpha,tab_bar.beta,tab_bar.delta FROM tab_bar WHERE (tab_bar.gamma=1) "
+				"ORDER BY tab_bar.beta ASC,tab_bar.alpha DESC LIMIT 2", db._statements[0]);
+		ok &= test::check<std::string>("next", "SELECT tab_bar.alpha,tab_bar.beta,tab_bar.delta FROM tab_bar WHERE (tab_bar.gamma=1) "
+				"AND ((tab_bar.beta>?) OR ((tab_bar.beta=?) AND (tab_bar.alpha<?))) ORDER BY tab_bar.beta ASC,tab_bar.alpha DESC LIMIT 2", db._statements[1]);
+
+		db._pages = {
+			{row_t{9, "a", 0}, row_t{8, "a", 0}},
+			{row_t{7, "b", 0}, row_t{5, "c", 0}},
+			{row_t{3, "d", 0}},
+		};
+		std::size_t pages = 0;
+		std::string alphas;
+		while (not pager.done())
+		{
+			for (const auto& row : pager.next())
+				alphas += std::to_string(row.alpha) + ' ';
+			++pages;
+		}
+		ok &= test::check<std::size_t>("pages", 3, pages);
+		ok &= test::check<std::string>("rows", "9 8 7 5 3 ", alphas);
+		ok &= test::check<std::string>("seek parameters", "0:a 1:a 2:8 0:c 1:c 2:5 ", db._bind_log);
+	}
+
+	// A full last page is followed by an empty one
+	{
+		db._statements.clear();
+		auto pager = sqlpp::keyset_pager(db, select(t.alpha).from(t).where(true).order_by(t.alpha.asc()), 1);
+		ok &= test::check<std::string>("single key", "SELECT tab_bar.alpha FROM tab_bar WHERE (tab_bar.alpha>?) ORDER BY tab_bar.alpha ASC LIMIT 1", db._statements[1]);
+
+		db._pages = {{row_t{1, "", 0}}};
+		db._bind_log.clear();
+		std::size_t pages = 0;
+		while (not pager.done())
+		{
+			auto page = pager.next();
+			while (not page.empty())
+				page.pop_front();
+			++pages;
+		}
+		ok &= test::check<std::size_t>("pages", 2, pages);
+		ok &= test::check<std::string>("single key parameter", "0:1 ", db._bind_log);
+	}
+
+	// Invalid page sizes are rejected before preparing anything
+	{
+		PagingDb preparing;
+		try
+		{
+			sqlpp::keyset_pager(preparing, select(t.alpha).from(t).where(true).order_by(t.alpha.asc()), 0);
+			std::cerr << "zero page size: expected exception" << std::endl;
+			ok = false;
+		}
+		catch (const sqlpp::exception&)
+		{
+		}
+		ok &= test::check<std::size_t>("zero page size prepares", 0, preparing._statements.size());
+	}
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,135 @@
+/*
+ * LiteralParameterizationTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/parameterizing_serializer_context.h>
+
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+	// Records the bound values like a connector's prepared statement would
+	struct bind_recorder_t
+	{
+		std::ostringstream _os;
+
+		void _bind_boolean_parameter(size_t index, const signed char* value, bool is_null)
+		{
+			_os << index << ":b" << (is_null ? "NULL" : std::to_string(*value)) << ' ';
+		}
+
+		void _bind_floating_point_parameter(size_t index, const double* value, bool is_null)
+		{
+			_os << index << ":f" << (is_null ? "NULL" : std::to_string(*value)) << ' ';
+		}
+
+		void _bind_integral_parameter(size_t index, const int64_t* value, bool is_null)
+		{
+			_os << index << ":i" << (is_null ? "NULL" : std::to_string(*value)) << ' ';
+		}
+
+		void _bind_text_parameter(size_t index, const std::string* value, bool is_null)
+		{
+			_os << index << ":t" << (is_null ? "NULL" : *value) << ' ';
+		}
+	};
+
+	template<typename T>
+		bool check(const T& t, const std::string& expectedText, const std::string& expectedBinds)
+		{
+			sqlpp::parameterizing_serializer_context_t context;
+			serialize(t, context);
+			bind_recorder_t recorder;
+			context._literals._bind(recorder);
+			if (context.str() != expectedText or recorder._os.str() != expectedBinds)
+			{
+				std::cerr << "expected: " << expectedText << " / " << expectedBinds << "\n";
+				std::cerr << "received: " << context.str() << " / " << recorder._os.str() << std::endl;
+				return false;
+			}
+			return true;
+		}
+}
+
+int main()
+{
+	test::TabBar t;
+
+	bool ok = true;
+
+	// Different literals, same text
+	ok &= check(select(t.alpha).from(t).where(t.alpha == 42), "SELECT tab_bar.alpha FROM tab_bar WHERE (tab_bar.alpha=?)", "0:i42 ");
+	ok &= check(select(t.alpha).from(t).where(t.alpha == 43), "SELECT tab_bar.alpha FROM tab_bar WHERE (tab_bar.alpha=?)", "0:i43 ");
+
+	// All operand types, in placeholder order
+	ok &= check(select(t.alpha).from(t).where(t.beta == "it's" and t.gamma == true and t.delta > 1.5).limit(10u),
+			"SELECT tab_bar.alpha FROM tab_bar WHERE (((tab_bar.beta=?) AND (tab_bar.gamma=?)) AND (tab_bar.delta>?)) LIMIT ?",
+			"0:tit's 1:b1 2:f1.500000 3:i10 ");
+	ok &= check(insert_into(t).set(t.beta = "cheese", t.gamma = false), "INSERT  INTO tab_bar (beta,gamma) VALUES(?,?)", "0:tcheese 1:b0 ");
+	ok &= check(update(t).set(t.delta = 17).where(t.alpha.in(1, 2)), "UPDATE tab_bar SET delta=? WHERE tab_bar.alpha IN(?,?)", "0:i17 1:i1 2:i2 ");
+
+	// The default contexts still inline literals
+	{
+		MockDb::_serializer_context_t context;
+		serialize(select(t.alpha).from(t).where(t.alpha == 42), context);
+		if (context.str() != "SELECT tab_bar.alpha FROM tab_bar WHERE (tab_bar.alpha=42)")
+		{
+			std::cerr << "unexpected inlined literal: " << context.str() << std::endl;
+			ok = false;
+		}
+	}
+
+	// Contexts for prepared statements inline literals, parameters remain placeholders
+	{
+		sqlpp::parameterizing_serializer_context_t context;
+		context._inline_literals = true;
+		serialize(select(t.alpha).from(t).where(t.alpha == 42 and t.beta == parameter(t.beta)), context);
+		if (context.str() != "SELECT tab_bar.alpha FROM tab_bar WHERE ((tab_bar.alpha=42) AND (tab_bar.beta=?))" or not context._literals.empty())
+		{
+			std::cerr << "unexpected literal in prepared statement: " << context.str() << std::endl;
+			ok = false;
+		}
+	}
+
+	// reset() clears text and values
+	{
+		sqlpp::parameterizing_serializer_context_t context;
+		serialize(t.alpha == 1, context);
+		context.reset();
+		if (not context.str().empty() or not context._literals.empty())
+		{
+			std::cerr << "reset() is expected to clear the literals" << std::endl;
+			ok = false;
+		}
+	}
+
+	return ok ? 0 : -1;
+}
@@ -27,11 +27,14 @@
 #define SQLPP_MOCK_DB_H
 
 #include <sstream>
+#include <deque>
 #include <iostream>
 #include <iomanip>
 #include <sqlpp11/schema.h>
 #include <sqlpp11/serializer_context.h>
+#include <sqlpp11/buffer_serializer_context.h>
 #include <sqlpp11/connection.h>
+#include <sqlpp11/prepared_statement_cache.h>
 
 template<bool enforceNullResultTreatment>
 struct MockDbT: public sqlpp::connection
@@ -40,36 +43,9 @@ struct MockDbT: public sqlpp::connection
 						::sqlpp::tag_if<::sqlpp::tag::enforce_null_result_treatment, enforceNullResultTreatment>
 					>;
 
-	struct _serializer_context_t
+	struct _serializer_context_t: public sqlpp::buffer_serializer_context_t
 	{
-		std::ostringstream _os;
-
-		_serializer_context_t() = default;
-		_serializer_context_t(const _serializer_context_t& rhs)
-		{
-			_os << rhs._os.str();
-		}
-
-		std::string str() const
-		{
-			return _os.str();
-		}
-
-		void reset()
-		{
-			_os.str("");
-		}
-
-		template<typename T>
-			std::ostream& operator<<(T t)
-			{
-				return _os << t;
-			}
-
-		static std::string escape(std::string arg)
-		{
-			return sqlpp::serializer_context_t::escape(arg);
-		}
+		using _use_static_sql = std::true_type;
 	};
 
 	using _interpreter_context_t = _serializer_context_t;
@@ -101,11 +77,19 @@ struct MockDbT: public sqlpp::connection
 			return true;
 		}
 
+		// Follows the bind-once lifecycle of connector_api/bind_result.h, but never yields a row
 		template<typename ResultRow>
 			void next(ResultRow& result_row)
 			{
-				result_row._invalidate();
+				result_row._bind_once(*this);
+				if (result_row)
+					result_row._invalidate();
 			}
+
+		void _bind_boolean_result(size_t, signed char*, bool*) {}
+		void _bind_floating_point_result(size_t, double*, bool*) {}
+		void _bind_integral_result(size_t, int64_t*, bool*) {}
+		void _bind_text_result(size_t, const char**, size_t*) {}
 	};
 
 	// Directly executed statements start here
@@ -188,7 +172,86 @@ struct MockDbT: public sqlpp::connection
 		}
 
 	// Prepared statements start here
-	using _prepared_statement_t = std::nullptr_t;
+	// Logs bound values, so that tests can inspect what _bind_params and run_batch saw
+	struct _prepared_statement_t
+	{
+		_prepared_statement_t() = default;
+		_prepared_statement_t(std::nullptr_t) {}
+
+		template<typename T>
+			static std::string _to_string(const T& t)
+			{
+				return std::to_string(t);
+			}
+
+		static std::string _to_string(const std::string& t)
+		{
+			return t;
+		}
+
+		template<typename T>
+			void _log_array(size_t index, const T* value, const bool* is_null, size_t stride, size_t count)
+			{
+				_log += std::to_string(index) + ':';
+				for (size_t i = 0; i < count; ++i)
+				{
+					const auto offset = i * stride;
+					if (*reinterpret_cast<const bool*>(reinterpret_cast<const char*>(is_null) + offset))
+						_log += "NULL";
+					else
+						_log += _to_string(*reinterpret_cast<const T*>(reinterpret_cast<const char*>(value) + offset));
+					_log += (i + 1 < count ? ',' : ' ');
+				}
+			}
+
+		template<typename T>
+			void _log_value(size_t index, const T* value, bool is_null)
+			{
+				_log += std::to_string(index) + ':' + (is_null ? std::string("NULL") : _to_string(*value)) + ' ';
+			}
+
+		void _bind_boolean_parameter(size_t index, const signed char* value, bool is_null)
+		{
+			_log_value(index, value, is_null);
+		}
+
+		void _bind_floating_point_parameter(size_t index, const double* value, bool is_null)
+		{
+			_log_value(index, value, is_null);
+		}
+
+		void _bind_integral_parameter(size_t index, const int64_t* value, bool is_null)
+		{
+			_log_value(index, value, is_null);
+		}
+
+		void _bind_text_parameter(size_t index, const std::string* value, bool is_null)
+		{
+			_log_value(index, value, is_null);
+		}
+
+		void _bind_boolean_parameter_array(size_t index, const signed char* value, const bool* is_null, size_t stride, size_t count)
+		{
+			_log_array(index, value, is_null, stride, count);
+		}
+
+		void _bind_floating_point_parameter_array(size_t index, const double* value, const bool* is_null, size_t stride, size_t count)
+		{
+			_log_array(index, value, is_null, stride, count);
+		}
+
+		void _bind_integral_parameter_array(size_t index, const int64_t* value, const bool* is_null, size_t stride, size_t count)
+		{
+			_log_array(index, value, is_null, stride, count);
+		}
+
+		void _bind_text_parameter_array(size_t index, const std::string* value, const bool* is_null, size_t stride, size_t count)
+		{
+			_log_array(index, value, is_null, stride, count);
+		}
+
+		std::string _log;
+	};
 
 	template<typename T>
 		auto _prepare(const T& t, const std::true_type&) -> decltype(t._prepare(*this))
@@ -228,6 +291,24 @@ struct MockDbT: public sqlpp::connection
 			return nullptr;
 		}
 
+	template<typename Update>
+		_prepared_statement_t prepare_update(Update& x)
+		{
+			_serializer_context_t context;
+			::sqlpp::serialize(x, context);
+			std::cout << "Running prepare update call with\n" << context.str() << std::endl;
+			return nullptr;
+		}
+
+	template<typename Remove>
+		_prepared_statement_t prepare_remove(Remove& x)
+		{
+			_serializer_context_t context;
+			::sqlpp::serialize(x, context);
+			std::cout << "Running prepare remove call with\n" << context.str() << std::endl;
+			return nullptr;
+		}
+
 	template<typename PreparedExecute>
 		size_t run_prepared_execute(const PreparedExecute& )
 		{
@@ -237,9 +318,34 @@ struct MockDbT: public sqlpp::connection
 	template<typename PreparedInsert>
 		size_t run_prepared_insert(const PreparedInsert& x)
 		{
+			x._bind_params();
+			_bind_log += x._prepared_statement._log;
+			x._prepared_statement._log.clear();
+			return 0;
+		}
+
+	template<typename PreparedUpdate>
+		size_t run_prepared_update(const PreparedUpdate& x)
+		{
+			x._bind_params();
+			_bind_log += x._prepared_statement._log;
+			x._prepared_statement._log.clear();
 			return 0;
 		}
 
+	template<typename PreparedRemove>
+		size_t run_prepared_remove(const PreparedRemove& x)
+		{
+			x._bind_params();
+			_bind_log += x._prepared_statement._log;
+			x._prepared_statement._log.clear();
+			if (_removed_rows.empty())
+				return 0;
+			const auto rows = _removed_rows.front();
+			_removed_rows.pop_front();
+			return rows;
+		}
+
 	template<typename Select>
 		_prepared_statement_t prepare_select(Select& x)
 		{
@@ -249,22 +355,117 @@ struct MockDbT: public sqlpp::connection
 			return nullptr;
 		}
 
+	template<typename PreparedStatement, typename Rows>
+		size_t run_batch(const PreparedStatement& p, const Rows& rows)
+		{
+			p._prepared_statement._log.clear();
+			p._bind_batch(rows.data(), rows.size());
+			return rows.size();
+		}
+
 	template<typename PreparedSelect>
 		result_t run_prepared_select(PreparedSelect& )
 		{
 			return {};
 		}
 
+	// Transactions, logged for inspection by tests
+	void start_transaction()
+	{
+		_transaction_log += "begin;";
+		_transaction_active = true;
+	}
+
+	void commit_transaction()
+	{
+		_transaction_log += "commit;";
+		_transaction_active = false;
+	}
+
+	void rollback_transaction(bool)
+	{
+		_transaction_log += "rollback;";
+		_transaction_active = false;
+	}
+
+	bool is_transaction_active() const
+	{
+		return _transaction_active;
+	}
+
+	void savepoint(const std::string& name)
+	{
+		_transaction_log += "savepoint " + name + ";";
+	}
+
+	void release_savepoint(const std::string& name)
+	{
+		_transaction_log += "release " + name + ";";
+	}
+
+	void rollback_to_savepoint(const std::string& name, bool)
+	{
+		_transaction_log += "rollback to " + name + ";";
+	}
+
+	void report_rollback_failure(const std::string&)
+	{}
+
+	std::string _transaction_log;
+	bool _transaction_active = false;
+
+	// Parameters bound by executed prepared inserts, updates and removes
+	std::string _bind_log;
+
+	// Results of executed prepared removes, 0 once exhausted
+	std::deque<size_t> _removed_rows;
+
+	// Prepared statement cache
+	template<typename T>
+		auto cached(const T& t) -> std::shared_ptr<decltype(this->prepare(t))>
+		{
+			return _statement_cache.get(*this, t);
+		}
+
+	sqlpp::prepared_statement_cache_t<MockDbT>& statement_cache()
+	{
+		return _statement_cache;
+	}
+
 	auto attach(std::string name)
 		-> ::sqlpp::schema_t
 		{
 			return {name};
 		}
 
+private:
+	sqlpp::prepared_statement_cache_t<MockDbT> _statement_cache;
 };
 
 using MockDb = MockDbT<false>;
 using EnforceDb = MockDbT<true>;
 
+// Serializes parameters as $1, $2, ... like PostgreSQL does
+struct NumberingContext: public sqlpp::buffer_serializer_context_t
+{
+	std::size_t _parameters = 0;
+};
+
+namespace sqlpp
+{
+	template<typename ValueType, typename NameType>
+		struct serializer_t<NumberingContext, parameter_t<ValueType, NameType>>
+		{
+			using _serialize_check = consistent_t;
+			using T = parameter_t<ValueType, NameType>;
+
+			static NumberingContext& _(const T&, NumberingContext& context)
+			{
+				context << '$' << ++context._parameters;
+				return context;
+			}
+		};
+}
+
 #endif
 
@@ -0,0 +1,117 @@
+/*
+ * PreparedStatementCacheTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+
+#include <iostream>
+
+namespace
+{
+	bool check_counters(const sqlpp::prepared_statement_cache_t<MockDb>& cache, std::size_t size, std::size_t hits, std::size_t misses, std::size_t evictions)
+	{
+		if (cache.size() != size or cache.hits() != hits or cache.misses() != misses or cache.evictions() != evictions)
+		{
+			std::cerr << "expected size/hits/misses/evictions: " << size << "/" << hits << "/" << misses << "/" << evictions << "\n";
+			std::cerr << "received size/hits/misses/evictions: " << cache.size() << "/" << cache.hits() << "/" << cache.misses() << "/" << cache.evictions() << std::endl;
+			return false;
+		}
+		return true;
+	}
+}
+
+int main()
+{
+	MockDb db;
+	test::TabBar t;
+
+	bool ok = true;
+	auto& cache = db.statement_cache();
+
+	// Static statements are keyed by type
+	{
+		const auto first = db.cached(select(t.alpha).from(t).where(t.alpha == parameter(t.alpha)));
+		const auto second = db.cached(select(t.alpha).from(t).where(t.alpha == parameter(t.alpha)));
+		ok &= check_counters(cache, 1, 1, 1, 0);
+		if (first != second)
+		{
+			std::cerr << "expected the cached prepared statement to be reused" << std::endl;
+			ok = false;
+		}
+		second->params.alpha = 7;
+		for (const auto& row : db(*second))
+		{
+			int64_t a = row.alpha;
+			(void) a;
+		}
+	}
+
+	// Literals and dynamic parts are part of the key
+	{
+		db.cached(select(t.alpha).from(t).where(t.alpha == 42));
+		db.cached(select(t.alpha).from(t).where(t.alpha == 43));
+		db.cached(select(t.alpha).from(t).where(t.alpha == 42));
+		ok &= check_counters(cache, 3, 2, 3, 0);
+
+		auto s = dynamic_select(db, t.alpha).from(t).dynamic_where();
+		db.cached(s);
+		s.where.add(t.beta == "cheese");
+		db.cached(s);
+		db.cached(s);
+		ok &= check_counters(cache, 5, 3, 5, 0);
+	}
+
+	// Least recently used entries are evicted first
+	{
+		cache.set_max_size(2);
+		ok &= check_counters(cache, 2, 3, 5, 3);
+
+		const auto held = db.cached(insert_into(t).set(t.gamma = parameter(t.gamma)));
+		db.cached(remove_from(t).where(t.alpha == parameter(t.alpha)));
+		db.cached(insert_into(t).set(t.gamma = parameter(t.gamma)));
+		db.cached(update(t).set(t.delta = parameter(t.delta)).where(true));
+		ok &= check_counters(cache, 2, 4, 8, 6);
+
+		// evicted statements stay usable
+		cache.clear();
+		held->params.gamma = true;
+		db(*held);
+		ok &= check_counters(cache, 0, 4, 8, 6);
+	}
+
+	// A cache of size zero prepares every time
+	{
+		cache.set_max_size(0);
+		db.cached(select(t.alpha).from(t).where(t.alpha == parameter(t.alpha)));
+		db.cached(select(t.alpha).from(t).where(t.alpha == parameter(t.alpha)));
+		ok &= check_counters(cache, 0, 4, 10, 6);
+	}
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,119 @@
+/*
+ * PurgeTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sqlpp11/declare_table.h>
+#include <sqlpp11/integral.h>
+#include <sqlpp11/purge.h>
+#include "MockDb.h"
+#include "Check.h"
+
+#include <iostream>
+#include <string>
+
+SQLPP_DECLARE_TABLE(
+	(event),
+	(id      , integer, is_primary_key)
+	(created , integer)
+);
+
+namespace
+{
+	// Counts the statements prepared
+	struct PreparingDb: public MockDb
+	{
+		std::size_t _prepares = 0;
+
+		template<typename T>
+			auto prepare(const T& t) -> decltype(t._prepare(*this))
+			{
+				++_prepares;
+				return t._prepare(*this);
+			}
+	};
+}
+
+int main()
+{
+	MockDb db;
+	event e;
+	bool ok = true;
+
+	// By default, batches are bounded by a sub-select on the primary key
+	{
+		MockDb::_serializer_context_t context;
+		serialize(sqlpp::detail::make_purge_statement(e, e.created < 10, 100, std::false_type{}), context);
+		ok &= test::check<std::string>("sub-select", "DELETE FROM event WHERE event.id IN(SELECT event.id FROM event WHERE (event.created<10) LIMIT 100)", context.str());
+	}
+
+	// or by DELETE ... LIMIT
+	{
+		MockDb::_serializer_context_t context;
+		serialize(sqlpp::detail::make_purge_statement(e, e.created < 10, 100, std::true_type{}), context);
+		ok &= test::check<std::string>("delete limit", "DELETE FROM event WHERE (event.created<10) LIMIT 100", context.str());
+	}
+
+	// Every batch is committed on its own, until a batch is not full
+	{
+		auto purger = sqlpp::purge(db, e, e.created < 10, 100);
+		db._removed_rows = {100, 100, 30, 100};
+		db._transaction_log.clear();
+		std::string progress;
+		const auto removed = purger.run([&progress](std::size_t batch, std::size_t total)
+				{
+					progress += std::to_string(batch) + '/' + std::to_string(total) + ' ';
+				});
+		ok &= test::check<std::size_t>("removed", 230, removed);
+		ok &= test::check<std::string>("progress", "100/100 100/200 30/230 ", progress);
+		ok &= test::check<std::string>("transactions", "begin;commit;begin;commit;begin;commit;", db._transaction_log);
+	}
+
+	// Nothing to remove, the pause only applies between batches
+	{
+		auto purger = sqlpp::purge(db, e, e.created < 10, 10, std::chrono::milliseconds{1});
+		db._removed_rows = {10, 0};
+		ok &= test::check<std::size_t>("paused", 10, purger.run());
+		ok &= test::check<std::size_t>("empty", 0, purger.run());
+	}
+
+	// Invalid batch sizes are rejected before preparing anything
+	{
+		PreparingDb preparing;
+		try
+		{
+			sqlpp::purge(preparing, e, e.created < 10, 0);
+			std::cerr << "zero batch size: expected exception" << std::endl;
+			ok = false;
+		}
+		catch (const sqlpp::exception&)
+		{
+		}
+		ok &= test::check<std::size_t>("zero batch size prepares", 0, preparing._prepares);
+	}
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,139 @@
+/*
+ * ReadAheadTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Check.h"
+#include <sqlpp11/read_ahead.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// Pages of consecutive numbers, optionally failing at one page
+	struct NumberPager
+	{
+		int _pages;
+		int _page_size;
+		int _failing_page;
+		std::atomic<int> _fetched;
+
+		NumberPager(int pages, int page_size, int failing_page = -1):
+			_pages(pages),
+			_page_size(page_size),
+			_failing_page(failing_page),
+			_fetched(0)
+		{}
+
+		bool done() const
+		{
+			return _fetched == _pages;
+		}
+
+		std::vector<int> next()
+		{
+			if (_fetched == _failing_page)
+				throw std::runtime_error("page failed");
+			std::vector<int> page;
+			for (int i = 0; i < _page_size; ++i)
+				page.push_back(_fetched * _page_size + i);
+			++_fetched;
+			return page;
+		}
+	};
+}
+
+int main()
+{
+	bool ok = true;
+
+	// Pages arrive in order, rows are converted by the worker
+	{
+		NumberPager pager(5, 3);
+		auto cursor = sqlpp::read_ahead(pager, [](int i) { return std::to_string(i); });
+		std::vector<std::string> page;
+		std::string received;
+		std::size_t pages = 0;
+		while (cursor.next(page))
+		{
+			for (const auto& value : page)
+				received += value + ' ';
+			++pages;
+		}
+		ok &= test::check<std::size_t>("pages", 5, pages);
+		ok &= test::check<std::string>("order", "0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 ", received);
+		ok &= test::check<bool>("exhausted", false, cursor.next(page));
+	}
+
+	// The worker fetches at most one page beyond the ready ones
+	{
+		NumberPager pager(10, 1);
+		auto cursor = sqlpp::read_ahead(pager, [](int i) { return i; }, 2);
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		ok &= test::check<bool>("bounded", true, pager._fetched <= 3);
+
+		std::vector<int> page;
+		int sum = 0;
+		while (cursor.next(page))
+			sum += page.front();
+		ok &= test::check<int>("all pages", 45, sum);
+	}
+
+	// Worker exceptions are rethrown after the pages fetched before
+	{
+		NumberPager pager(5, 1, 2);
+		auto cursor = sqlpp::read_ahead(pager, [](int i) { return i; });
+		std::vector<int> page;
+		std::size_t pages = 0;
+		try
+		{
+			while (cursor.next(page))
+				++pages;
+			std::cerr << "failing page: expected exception" << std::endl;
+			ok = false;
+		}
+		catch (const std::runtime_error&)
+		{
+		}
+		ok &= test::check<std::size_t>("pages before failure", 2, pages);
+	}
+
+	// Abandoned cursors stop the worker
+	{
+		NumberPager pager(1000, 1);
+		auto cursor = sqlpp::read_ahead(pager, [](int i) { return i; }, 1);
+		std::vector<int> page;
+		cursor.next(page);
+	}
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,256 @@
+/*
+ * ResultRowBenchmark.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Per-row overhead of iterating a result: rebinding every field on each step
+// compared to binding once per result set, and to a raw loop over the data.
+// Connectors are typically compiled libraries, so their methods are not inlined here either.
+#if defined(_MSC_VER)
+#define SQLPP_BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define SQLPP_BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+namespace
+{
+	struct table_t
+	{
+		std::vector<int64_t> _alpha;
+		std::vector<std::string> _beta;
+		std::vector<signed char> _gamma;
+		std::vector<int64_t> _delta;
+
+		std::size_t size() const
+		{
+			return _alpha.size();
+		}
+	};
+
+	// Cursor of a C API that exposes the current row through column accessors
+	struct cursor_t
+	{
+		const table_t* _table;
+		std::size_t _row;
+
+		SQLPP_BENCHMARK_NOINLINE bool step()
+		{
+			return ++_row < _table->size();
+		}
+	};
+
+	// Old lifecycle: bind all fields on every step, reading the current values
+	struct rebind_result_t
+	{
+		cursor_t _cursor;
+
+		template<typename ResultRow>
+			void next(ResultRow& result_row)
+			{
+				if (_cursor.step())
+				{
+					if (not result_row)
+						result_row._validate();
+					result_row._bind(*this);
+				}
+				else if (result_row)
+					result_row._invalidate();
+			}
+
+		SQLPP_BENCHMARK_NOINLINE void _bind_integral_result(size_t index, int64_t* value, bool* is_null)
+		{
+			*value = index == 0 ? _cursor._table->_alpha[_cursor._row] : _cursor._table->_delta[_cursor._row];
+			*is_null = false;
+		}
+
+		SQLPP_BENCHMARK_NOINLINE void _bind_text_result(size_t, const char** value, size_t* len)
+		{
+			const auto& text = _cursor._table->_beta[_cursor._row];
+			*value = text.data();
+			*len = text.size();
+		}
+
+		SQLPP_BENCHMARK_NOINLINE void _bind_boolean_result(size_t, signed char* value, bool* is_null)
+		{
+			*value = _cursor._table->_gamma[_cursor._row];
+			*is_null = false;
+		}
+
+		bool operator==(const rebind_result_t& rhs) const
+		{
+			return _cursor._row == rhs._cursor._row;
+		}
+	};
+
+	// New lifecycle: bind once, then write the current values through the stored pointers
+	struct bind_once_result_t
+	{
+		cursor_t _cursor;
+		int64_t* _alpha;
+		const char** _beta;
+		size_t* _beta_len;
+		signed char* _gamma;
+		int64_t* _delta;
+		bool* _alpha_is_null;
+		bool* _gamma_is_null;
+		bool* _delta_is_null;
+
+		template<typename ResultRow>
+			void next(ResultRow& result_row)
+			{
+				result_row._bind_once(*this);
+				if (_fetch())
+				{
+					if (not result_row)
+						result_row._validate();
+				}
+				else if (result_row)
+					result_row._invalidate();
+			}
+
+		// Steps and writes the current values through the stored pointers
+		SQLPP_BENCHMARK_NOINLINE bool _fetch()
+		{
+			if (not _cursor.step())
+				return false;
+			const auto row = _cursor._row;
+			*_alpha = _cursor._table->_alpha[row];
+			*_alpha_is_null = false;
+			*_beta = _cursor._table->_beta[row].data();
+			*_beta_len = _cursor._table->_beta[row].size();
+			*_gamma = _cursor._table->_gamma[row];
+			*_gamma_is_null = false;
+			*_delta = _cursor._table->_delta[row];
+			*_delta_is_null = false;
+			return true;
+		}
+
+		SQLPP_BENCHMARK_NOINLINE void _bind_integral_result(size_t index, int64_t* value, bool* is_null)
+		{
+			(index == 0 ? _alpha : _delta) = value;
+			(index == 0 ? _alpha_is_null : _delta_is_null) = is_null;
+		}
+
+		SQLPP_BENCHMARK_NOINLINE void _bind_text_result(size_t, const char** value, size_t* len)
+		{
+			_beta = value;
+			_beta_len = len;
+		}
+
+		SQLPP_BENCHMARK_NOINLINE void _bind_boolean_result(size_t, signed char* value, bool* is_null)
+		{
+			_gamma = value;
+			_gamma_is_null = is_null;
+		}
+
+		bool operator==(const bind_once_result_t& rhs) const
+		{
+			return _cursor._row == rhs._cursor._row;
+		}
+	};
+
+	template<typename DbResult>
+		struct BenchmarkDb: public MockDb
+		{
+			const table_t* _table;
+
+			template<typename T>
+				auto operator() (const T& t) -> decltype(t._run(*this))
+				{
+					return t._run(*this);
+				}
+
+			template<typename Select>
+				DbResult select(const Select&)
+				{
+					DbResult result{};
+					result._cursor = {_table, static_cast<std::size_t>(-1)};
+					return result;
+				}
+		};
+
+	template<typename DbResult>
+		double run(const std::string& name, const table_t& table)
+		{
+			test::TabBar t;
+			BenchmarkDb<DbResult> db;
+			db._table = &table;
+
+			int64_t sum = 0;
+			const auto start = std::chrono::steady_clock::now();
+			for (const auto& row : db(select(t.alpha, t.beta, t.gamma, t.delta).from(t).where(true)))
+			{
+				sum += row.alpha + row.delta + static_cast<int64_t>(row.beta.size()) + row.gamma;
+			}
+			const auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(table.size());
+			std::cout << name << ": " << duration << " ns/row (checksum " << sum << ")" << std::endl;
+			return duration;
+		}
+
+	double run_raw(const table_t& table)
+	{
+		int64_t sum = 0;
+		const auto start = std::chrono::steady_clock::now();
+		cursor_t cursor{&table, static_cast<std::size_t>(-1)};
+		while (cursor.step())
+		{
+			const auto row = cursor._row;
+			sum += table._alpha[row] + table._delta[row] + static_cast<int64_t>(table._beta[row].size()) + table._gamma[row];
+		}
+		const auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(table.size());
+		std::cout << "raw cursor loop  : " << duration << " ns/row (checksum " << sum << ")" << std::endl;
+		return duration;
+	}
+}
+
+int main()
+{
+	const std::size_t rowCount = 2000000;
+
+	table_t table;
+	for (std::size_t i = 0; i < rowCount; ++i)
+	{
+		table._alpha.push_back(static_cast<int64_t>(i));
+		table._beta.push_back(std::to_string(i));
+		table._gamma.push_back(static_cast<signed char>(i % 2));
+		table._delta.push_back(static_cast<int64_t>(i % 7));
+	}
+
+	run<rebind_result_t>("rebind every row ", table);
+	run<bind_once_result_t>("bind once        ", table);
+	run_raw(table);
+
+	return 0;
+}
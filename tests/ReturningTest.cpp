@@ -0,0 +1,103 @@
+/*
+ * ReturningTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include "Check.h"
+#include <sqlpp11/sqlpp11.h>
+
+#include <iostream>
+
+namespace
+{
+	template<typename T>
+		std::string to_sql(const T& t)
+		{
+			MockDb::_serializer_context_t context;
+			serialize(t, context);
+			return context.str();
+		}
+}
+
+int main()
+{
+	MockDb db;
+	test::TabBar t;
+	test::TabFoo f;
+
+	bool ok = true;
+
+	// Serialization
+	{
+		auto i = insert_into(t).set(t.beta = "a", t.gamma = true).returning(t.alpha);
+		ok &= test::check<std::string>("insert", "INSERT  INTO tab_bar (beta,gamma) VALUES('a',1) RETURNING tab_bar.alpha", to_sql(i));
+
+		auto u = update(t).set(t.gamma = false).where(t.alpha == 1).returning(t.alpha, t.beta);
+		ok &= test::check<std::string>("update", "UPDATE tab_bar SET gamma=0 WHERE (tab_bar.alpha=1) RETURNING tab_bar.alpha,tab_bar.beta", to_sql(u));
+
+		auto r = remove_from(t).where(t.alpha == 1).returning(all_of(t));
+		ok &= test::check<std::string>("remove", "DELETE FROM tab_bar WHERE (tab_bar.alpha=1) RETURNING tab_bar.alpha,tab_bar.beta,tab_bar.gamma,tab_bar.delta", to_sql(r));
+
+		auto c = insert_into(t).set(t.beta = "a", t.gamma = true).on_conflict(t.beta).do_update(t.gamma = sqlpp::excluded(t.gamma)).returning(t.alpha);
+		ok &= test::check<std::string>("upsert", "INSERT  INTO tab_bar (beta,gamma) VALUES('a',1) ON CONFLICT (beta) DO UPDATE SET gamma=excluded.gamma RETURNING tab_bar.alpha", to_sql(c));
+	}
+
+	// Results are typed like those of a select
+	{
+		for (const auto& row : db(insert_into(t).set(t.beta = "a", t.gamma = true).returning(t.alpha, (t.delta + 1).as(f.epsilon))))
+		{
+			int64_t alpha = row.alpha;
+			int64_t epsilon = row.epsilon;
+			(void) alpha;
+			(void) epsilon;
+		}
+
+		using R = decltype(update(t).set(t.gamma = false).where(true).returning(t.alpha));
+		using S = decltype(select(t.alpha).from(t).where(true));
+		static_assert(std::is_same<R::_result_row_t<MockDb>, S::_result_row_t<MockDb>>::value, "returning and select rows have the same type");
+
+		using foreign = decltype(update(t).set(t.gamma = false).where(true).returning(f.omega));
+		static_assert(not sqlpp::prepare_check_t<foreign>::type::value, "returned columns have to be known to the statement");
+	}
+
+	// Prepared
+	{
+		auto p = db.prepare(insert_into(t).set(t.beta = parameter(t.beta), t.gamma = parameter(t.gamma)).returning(t.alpha));
+		p.params.beta = "a";
+		p.params.gamma = true;
+		for (const auto& row : db(p))
+		{
+			int64_t alpha = row.alpha;
+			(void) alpha;
+		}
+		p._bind_params();
+		ok &= test::check<std::string>("prepared", "0:a 1:1 ", p._prepared_statement._log);
+	}
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,131 @@
+/*
+ * SavepointTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sqlpp11/sqlpp11.h>
+#include "MockDb.h"
+#include "Check.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	// Fails rolling back to savepoints, reports failures
+	struct FailingDb: public MockDb
+	{
+		std::string _failures;
+
+		void rollback_to_savepoint(const std::string&, bool)
+		{
+			throw std::runtime_error("connection lost");
+		}
+
+		void report_rollback_failure(const std::string& message)
+		{
+			_failures += message;
+		}
+	};
+}
+
+int main()
+{
+	bool ok = true;
+
+	// Savepoints are released, rolled back explicitly or when destroyed, and can be nested
+	{
+		MockDb db;
+		auto tx = sqlpp::start_transaction(db);
+		{
+			auto first = tx.savepoint();
+			first.release();
+			auto second = tx.savepoint();
+			second.rollback();
+			auto third = tx.savepoint();
+			{
+				auto nested = third.savepoint();
+				ok &= test::check<std::string>("name", "sqlpp_savepoint_4", nested.name());
+			}
+			third.release();
+		}
+		tx.commit();
+		ok &= test::check<std::string>("log", "begin;"
+				"savepoint sqlpp_savepoint_1;release sqlpp_savepoint_1;"
+				"savepoint sqlpp_savepoint_2;rollback to sqlpp_savepoint_2;"
+				"savepoint sqlpp_savepoint_3;savepoint sqlpp_savepoint_4;rollback to sqlpp_savepoint_4;release sqlpp_savepoint_3;"
+				"commit;", db._transaction_log);
+	}
+
+	// Moved savepoints are finished by their new owner only
+	{
+		MockDb db;
+		auto tx = sqlpp::start_transaction(db);
+		{
+			auto sp = tx.savepoint();
+			auto moved = std::move(sp);
+			moved.release();
+		}
+		tx.commit();
+		ok &= test::check<std::string>("moved", "begin;savepoint sqlpp_savepoint_1;release sqlpp_savepoint_1;commit;", db._transaction_log);
+	}
+
+	// Savepoints outlive a move of their transaction, which is finished by its new owner only
+	{
+		MockDb db;
+		auto tx = sqlpp::start_transaction(db);
+		{
+			auto sp = tx.savepoint();
+			auto moved = std::move(tx);
+			{
+				auto nested = sp.savepoint();
+				ok &= test::check<std::string>("nested after move", "sqlpp_savepoint_2", nested.name());
+				nested.release();
+			}
+			sp.release();
+			ok &= test::check<std::string>("next after move", "sqlpp_savepoint_3", moved.savepoint().name());
+			moved.commit();
+		}
+		ok &= test::check<std::string>("moved transaction", "begin;"
+				"savepoint sqlpp_savepoint_1;savepoint sqlpp_savepoint_2;release sqlpp_savepoint_2;release sqlpp_savepoint_1;"
+				"savepoint sqlpp_savepoint_3;rollback to sqlpp_savepoint_3;"
+				"commit;", db._transaction_log);
+	}
+
+	// Failing automatic rollbacks are reported, not thrown
+	{
+		FailingDb db;
+		auto tx = sqlpp::start_transaction(db);
+		{
+			auto sp = tx.savepoint();
+		}
+		tx.commit();
+		ok &= test::check<std::string>("reported", "auto rollback to savepoint failed: connection lost", db._failures);
+	}
+
+	return ok ? 0 : -1;
+}
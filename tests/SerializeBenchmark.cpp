@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/buffer_serializer_context.h>
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+// Compares the std::ostream based serializer context with the buffer context
+namespace
+{
+	struct ostream_context_t
+	{
+		std::ostringstream _os;
+
+		std::string str() const
+		{
+			return _os.str();
+		}
+
+		void reset()
+		{
+			_os.str("");
+		}
+
+		template<typename T>
+			std::ostream& operator<<(T t)
+			{
+				return _os << t;
+			}
+
+		static std::string escape(std::string arg)
+		{
+			return sqlpp::serializer_context_t::escape(arg);
+		}
+	};
+
+	template<typename Context, typename Statement>
+		double run(const std::string& name, const Statement& statement, std::size_t iterations)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			std::size_t size = 0;
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				Context context; // fresh context per statement, like the connectors do
+				serialize(statement, context);
+				size += context.str().size();
+			}
+			const auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(iterations);
+			std::cout << name << ": " << duration << " ns/statement (" << size << " bytes)" << std::endl;
+			return duration;
+		}
+
+	template<typename Statement>
+		double run_reused(const std::string& name, const Statement& statement, std::size_t iterations)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			std::size_t size = 0;
+			sqlpp::buffer_serializer_context_t context;
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				context.reset();
+				serialize(statement, context);
+				size += context.size();
+			}
+			const auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(iterations);
+			std::cout << name << ": " << duration << " ns/statement (" << size << " bytes)" << std::endl;
+			return duration;
+		}
+
+	template<typename Statement>
+		void compare(const std::string& name, const Statement& statement, std::size_t iterations)
+		{
+			run<ostream_context_t>(name + " ostream", statement, iterations);
+			run<sqlpp::buffer_serializer_context_t>(name + " buffer", statement, iterations);
+			run_reused(name + " buffer (reset)", statement, iterations);
+		}
+}
+
+int main(int argc, char** argv)
+{
+	const std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+	test::TabBar t;
+
+	compare("insert", insert_into(t).set(t.beta = "cheesecake", t.gamma = true, t.delta = 42), iterations);
+	compare("update", update(t).set(t.beta = "it's", t.delta = 17).where(t.alpha == 1234567890 and t.delta > 3.25), iterations);
+	compare("select", select(all_of(t)).from(t).where(t.alpha > 17 and t.beta.like("%kuchen")).order_by(t.delta.asc()).limit(100u).offset(5000u), iterations);
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/buffer_serializer_context.h>
+
+#include <iostream>
+#include <limits>
+
+namespace
+{
+	template<typename T>
+		bool check(const T& t, const std::string& expected)
+		{
+			MockDb::_serializer_context_t context;
+			serialize(t, context);
+			if (context.str() != expected)
+			{
+				std::cerr << "expected: " << expected << "\nreceived: " << context.str() << std::endl;
+				return false;
+			}
+			return true;
+		}
+}
+
+int main()
+{
+	test::TabBar t;
+
+	bool ok = true;
+
+	// integral fast path
+	ok &= check(t.alpha == 0, "(tab_bar.alpha=0)");
+	ok &= check(t.alpha == -17, "(tab_bar.alpha=-17)");
+	ok &= check(t.alpha == std::numeric_limits<int64_t>::max(), "(tab_bar.alpha=9223372036854775807)");
+	ok &= check(t.alpha == std::numeric_limits<int64_t>::min(), "(tab_bar.alpha=-9223372036854775808)");
+	ok &= check(select(t.alpha).from(t).where(t.delta > 5u).limit(17u).offset(3u), "SELECT tab_bar.alpha FROM tab_bar WHERE (tab_bar.delta>5) LIMIT 17 OFFSET 3");
+
+	// floating point fast path
+	ok &= check(t.alpha == 3.0, "(tab_bar.alpha=3)");
+	ok &= check(t.alpha == -0.0, "(tab_bar.alpha=0)");
+	ok &= check(t.alpha == 0.1, "(tab_bar.alpha=0.1)");
+	ok &= check(t.alpha == 1234567.125, "(tab_bar.alpha=1234567.125)");
+	ok &= check(t.alpha == 1e100, "(tab_bar.alpha=1e+100)");
+
+	// text and escaping
+	ok &= check(t.beta == "", "(tab_bar.beta='')");
+	ok &= check(t.beta == "'", "(tab_bar.beta='''')");
+	ok &= check(t.beta == "it's", "(tab_bar.beta='it''s')");
+
+	// reset keeps the capacity
+	{
+		sqlpp::buffer_serializer_context_t context(1024);
+		const auto capacity = context.str().capacity();
+		serialize(select(all_of(t)).from(t).where(t.beta == "cheesecake"), context);
+		context.reset();
+		if (not context.str().empty() or context.str().capacity() != capacity)
+		{
+			std::cerr << "reset() is expected to keep the buffer" << std::endl;
+			ok = false;
+		}
+	}
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,146 @@
+/*
+ * StatementShapeTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+
+#include <iostream>
+
+namespace
+{
+	template<typename Statement>
+		std::string to_sql(const Statement& statement)
+		{
+			MockDb::_serializer_context_t context;
+			serialize(statement, context);
+			return context.str();
+		}
+
+	template<typename Db>
+		auto make_select(Db& db, bool with_gamma)
+		-> decltype(dynamic_select(db, test::TabBar{}.alpha).from(test::TabBar{}).dynamic_where())
+		{
+			const auto t = test::TabBar{};
+			auto s = dynamic_select(db, t.alpha).from(t).dynamic_where();
+			s.where.add(t.beta == parameter(t.beta));
+			if (with_gamma)
+				s.where.add(t.gamma == parameter(t.gamma));
+			return s;
+		}
+}
+
+int main()
+{
+	MockDb db;
+	test::TabBar t;
+
+	bool ok = true;
+
+	// Statements built the same way have the same shape, and the shape determines the SQL text
+	{
+		const auto a = make_select(db, true);
+		const auto b = make_select(db, true);
+		const auto c = make_select(db, false);
+		const auto shape_a = sqlpp::shape_of(a);
+
+		if (shape_a != sqlpp::shape_of(b) or shape_a.hash() != sqlpp::shape_of(b).hash())
+		{
+			std::cerr << "expected equal shapes" << std::endl;
+			ok = false;
+		}
+		if (shape_a == sqlpp::shape_of(c) or shape_a.size() != 2)
+		{
+			std::cerr << "expected the dynamic parts to be part of the shape" << std::endl;
+			ok = false;
+		}
+		if (not shape_a.determines_sql() or to_sql(a) != to_sql(b))
+		{
+			std::cerr << "expected the shape to determine the SQL text" << std::endl;
+			ok = false;
+		}
+	}
+
+	// The order of dynamic parts matters
+	{
+		auto a = dynamic_select(db, t.alpha).from(t).dynamic_where();
+		a.where.add(t.beta == parameter(t.beta));
+		a.where.add(t.alpha == parameter(t.alpha));
+		auto b = dynamic_select(db, t.alpha).from(t).dynamic_where();
+		b.where.add(t.alpha == parameter(t.alpha));
+		b.where.add(t.beta == parameter(t.beta));
+		if (sqlpp::shape_of(a) == sqlpp::shape_of(b))
+		{
+			std::cerr << "expected different shapes" << std::endl;
+			ok = false;
+		}
+	}
+
+	// Literal values are not captured by the shape
+	{
+		auto a = dynamic_select(db, t.alpha).from(t).dynamic_where();
+		a.where.add(t.beta == "cheese");
+		auto b = dynamic_select(db, t.alpha).from(t).dynamic_where(t.alpha == 17);
+		if (sqlpp::shape_of(a).determines_sql() or sqlpp::shape_of(b).determines_sql())
+		{
+			std::cerr << "expected literals to require serialization" << std::endl;
+			ok = false;
+		}
+		if (not sqlpp::shape_of(select(t.alpha).from(t).where(t.alpha == parameter(t.alpha))).determines_sql())
+		{
+			std::cerr << "expected static statements without literals to be determined by their type" << std::endl;
+			ok = false;
+		}
+	}
+
+	// The statement cache reuses prepared statements for equal shapes
+	{
+		auto& cache = db.statement_cache();
+		const auto first = db.cached(make_select(db, true));
+		const auto second = db.cached(make_select(db, true));
+		db.cached(make_select(db, false));
+		if (first != second or cache.hits() != 1 or cache.misses() != 2)
+		{
+			std::cerr << "expected one hit and two misses, got " << cache.hits() << "/" << cache.misses() << std::endl;
+			ok = false;
+		}
+
+		// Literals fall back to the serialized text
+		auto a = dynamic_select(db, t.alpha).from(t).dynamic_where();
+		a.where.add(t.beta == "cheese");
+		auto b = dynamic_select(db, t.alpha).from(t).dynamic_where();
+		b.where.add(t.beta == "cake");
+		if (db.cached(a) == db.cached(b))
+		{
+			std::cerr << "expected different literals to be prepared separately" << std::endl;
+			ok = false;
+		}
+	}
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/static_sql.h>
+
+#include <iostream>
+
+namespace
+{
+	// Compares the compile time text with the text created by the serializers
+	template<typename T>
+		bool check(const T& t, const std::string& expected)
+		{
+			static_assert(sqlpp::has_static_sql_t<T>::value, "expected static SQL text");
+			static_assert(not sqlpp::uses_static_sql_t<sqlpp::buffer_serializer_context_t>::value, "context must serialize at runtime");
+			sqlpp::buffer_serializer_context_t context;
+			serialize(t, context);
+
+			MockDb::_serializer_context_t static_context;
+			serialize(t, static_context);
+
+			const std::string text = sqlpp::static_sql_text_t<T>::_text;
+			if (text != context.str() or text != expected or static_context.str() != expected
+					or sqlpp::static_sql_text_t<T>::_size != expected.size())
+			{
+				std::cerr << "expected: " << expected << "\nstatic:   " << text << "\nruntime:  " << context.str() << std::endl;
+				return false;
+			}
+			return true;
+		}
+}
+
+int main()
+{
+	MockDb db = {};
+
+	test::TabFoo f;
+	test::TabBar t;
+
+	bool ok = true;
+
+	ok &= check(t.alpha, "tab_bar.alpha");
+	ok &= check(t.alpha == parameter(t.alpha), "(tab_bar.alpha=?)");
+	ok &= check(not (t.alpha < t.delta), "(NOT (tab_bar.alpha<tab_bar.delta))");
+	ok &= check(select(all_of(t)).from(t).where(t.alpha == parameter(t.alpha)),
+			"SELECT tab_bar.alpha,tab_bar.beta,tab_bar.gamma,tab_bar.delta FROM tab_bar WHERE (tab_bar.alpha=?)");
+	ok &= check(select(t.alpha).flags(sqlpp::distinct).from(t, f)
+			.where(t.beta.like(parameter(t.beta)) and t.delta != f.epsilon)
+			.group_by(t.alpha).having(t.alpha > parameter(t.delta))
+			.order_by(t.alpha.asc(), t.beta.desc()).limit(parameter(t.delta)).offset(parameter(f.epsilon)),
+			"SELECT DISTINCT tab_bar.alpha FROM tab_bar,tab_foo WHERE (tab_bar.beta LIKE(?) AND (tab_bar.delta!=tab_foo.epsilon)) "
+			"GROUP BY tab_bar.alpha HAVING (tab_bar.alpha>?) ORDER BY tab_bar.alpha ASC,tab_bar.beta DESC LIMIT ? OFFSET ?");
+	ok &= check(remove_from(t).where(t.alpha == parameter(t.alpha)), "DELETE FROM tab_bar WHERE (tab_bar.alpha=?)");
+
+	// Literal values and dynamic parts are only known at runtime
+	static_assert(not sqlpp::has_static_sql_t<decltype(t.alpha == 17)>::value, "literals are not static");
+	static_assert(not sqlpp::has_static_sql_t<decltype(select(t.alpha).from(t).where(true))>::value, "literals are not static");
+	static_assert(not sqlpp::has_static_sql_t<decltype(select(t.alpha).from(t).where(t.alpha == 17))>::value, "literals are not static");
+	static_assert(not sqlpp::has_static_sql_t<decltype(dynamic_select(db).dynamic_columns(t.alpha).from(t).where(t.alpha == parameter(t.alpha)))>::value, "dynamic parts are not static");
+	static_assert(not sqlpp::has_static_sql_t<decltype(insert_into(t).set(t.gamma = parameter(t.gamma)))>::value, "not supported for insert");
+
+	// Statements with runtime text still serialize in a context using static SQL
+	{
+		MockDb::_serializer_context_t context;
+		serialize(select(t.alpha).from(t).where(t.alpha == 17), context);
+		if (context.str() != "SELECT tab_bar.alpha FROM tab_bar WHERE (tab_bar.alpha=17)")
+		{
+			std::cerr << "unexpected: " << context.str() << std::endl;
+			ok = false;
+		}
+	}
+
+	return ok ? 0 : -1;
+}
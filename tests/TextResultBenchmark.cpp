@@ -0,0 +1,185 @@
+/*
+ * TextResultBenchmark.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/buffer_serializer_context.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Counts heap allocations while scanning text result fields.
+// The synthetic connector hands out pointers into its own buffers, like a
+// real connector does with the rows it received from the database.
+namespace
+{
+	std::size_t allocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+	++allocations;
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace
+{
+	struct synthetic_result_t
+	{
+		const std::vector<std::string>* _texts;
+		std::size_t _row;
+
+		template<typename ResultRow>
+			void next(ResultRow& result_row)
+			{
+				if (_row == _texts->size())
+				{
+					result_row._invalidate();
+					return;
+				}
+				result_row._validate();
+				result_row._bind(*this);
+				++_row;
+			}
+
+		void _bind_text_result(std::size_t, const char** value, std::size_t* len)
+		{
+			const auto& text = (*_texts)[_row];
+			*value = text.data();
+			*len = text.size();
+		}
+
+		bool operator==(const synthetic_result_t& rhs) const
+		{
+			return _texts == rhs._texts and _row == rhs._row;
+		}
+	};
+
+	struct SyntheticDb: public MockDb
+	{
+		std::vector<std::string> _texts;
+
+		template<typename T>
+			auto operator() (const T& t) -> decltype(t._run(*this))
+			{
+				return t._run(*this);
+			}
+
+		template<typename Select>
+			synthetic_result_t select(const Select&)
+			{
+				return {&_texts, 0};
+			}
+	};
+
+	using beta_field_t = decltype(std::declval<decltype(select(test::TabBar{}.beta).from(test::TabBar{}))::_result_row_t<SyntheticDb>>().beta);
+
+	template<typename Scan>
+		void run(const std::string& name, SyntheticDb& db, Scan scan)
+		{
+			test::TabBar t;
+			std::size_t rows = 0;
+			std::size_t matches = 0;
+			auto result = db(select(t.beta).from(t).where(true));
+			const auto start = std::chrono::steady_clock::now();
+			const auto before = allocations;
+			for (const auto& row : result)
+			{
+				matches += scan(row.beta);
+				++rows;
+			}
+			const auto allocated = allocations - before;
+			const auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(rows);
+			std::cout << name << ": " << duration << " ns/row, "
+				<< static_cast<double>(allocated) / static_cast<double>(rows) << " allocations/row (" << matches << " matches)" << std::endl;
+		}
+}
+
+int main()
+{
+	const std::size_t rowCount = 1000000;
+	const std::string needle = "a text that does not fit into the small string buffer 500";
+
+	SyntheticDb db;
+	db._texts.reserve(rowCount);
+	for (std::size_t i = 0; i < rowCount; ++i)
+		db._texts.push_back("a text that does not fit into the small string buffer " + std::to_string(i % 1000));
+
+	run("compare value()", db, [&](const beta_field_t& field)
+			{
+				return field.value() == needle;
+			});
+	run("compare field ", db, [&](const beta_field_t& field)
+			{
+				return field == needle;
+			});
+	run("compare view() ", db, [&](const beta_field_t& field)
+			{
+				return field.view() == needle;
+			});
+
+	{
+		sqlpp::buffer_serializer_context_t context(1024);
+		run("serialize field", db, [&](const beta_field_t& field)
+				{
+					context.reset();
+					serialize(field, context);
+					return context.size() > needle.size();
+				});
+	}
+
+	{
+		std::ostringstream os;
+		run("stream field   ", db, [&](const beta_field_t& field)
+				{
+					os.seekp(0);
+					os << field;
+					return false;
+				});
+	}
+
+	return 0;
+}
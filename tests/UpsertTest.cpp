@@ -0,0 +1,117 @@
+/*
+ * UpsertTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include "Check.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/chunked_insert.h>
+
+#include <iostream>
+
+namespace
+{
+	template<typename T>
+		std::string to_sql(const T& t)
+		{
+			MockDb::_serializer_context_t context;
+			serialize(t, context);
+			return context.str();
+		}
+}
+
+int main()
+{
+	MockDb db;
+	test::TabBar t;
+	test::TabFoo f;
+
+	bool ok = true;
+
+	// Serialization
+	{
+		ok &= test::check<std::string>("do nothing", "INSERT  INTO tab_bar (beta,gamma) VALUES('a',1) ON CONFLICT (beta) DO NOTHING",
+				to_sql(insert_into(t).set(t.beta = "a", t.gamma = true).on_conflict(t.beta).do_nothing()));
+		ok &= test::check<std::string>("do nothing without target", "INSERT  INTO tab_bar (beta,gamma) VALUES('a',1) ON CONFLICT DO NOTHING",
+				to_sql(insert_into(t).set(t.beta = "a", t.gamma = true).on_conflict().do_nothing()));
+		ok &= test::check<std::string>("do update", "INSERT  INTO tab_bar (beta,gamma,delta) VALUES('a',1,1) ON CONFLICT (beta,gamma) DO UPDATE SET delta=(tab_bar.delta+excluded.delta),gamma=0",
+				to_sql(insert_into(t).set(t.beta = "a", t.gamma = true, t.delta = 1).on_conflict(t.beta, t.gamma).do_update(t.delta = t.delta + sqlpp::excluded(t.delta), t.gamma = false)));
+	}
+
+	// Compile time checks against the table inserted into
+	{
+		using missing_action = decltype(insert_into(t).set(t.beta = "a", t.gamma = true).on_conflict(t.beta));
+		static_assert(not sqlpp::prepare_check_t<missing_action>::type::value, "on_conflict() without action must not be prepared");
+
+		using foreign_target = decltype(insert_into(t).set(t.beta = "a", t.gamma = true).on_conflict(f.omega).do_nothing());
+		static_assert(not sqlpp::prepare_check_t<foreign_target>::type::value, "on_conflict() columns have to be of the table inserted into");
+
+		using foreign_excluded = decltype(insert_into(t).set(t.beta = "a", t.gamma = true).on_conflict(t.beta).do_update(t.delta = sqlpp::excluded(f.omega)));
+		static_assert(not sqlpp::prepare_check_t<foreign_excluded>::type::value, "excluded() columns have to be of the table inserted into");
+
+		using valid = decltype(insert_into(t).set(t.beta = "a", t.gamma = true).on_conflict(t.beta).do_update(t.delta = sqlpp::excluded(t.delta)));
+		static_assert(sqlpp::prepare_check_t<valid>::type::value, "valid upsert");
+	}
+
+	// Prepared and batched, parameters in do_update() follow those of the values
+	{
+		auto p = db.prepare(insert_into(t).set(t.beta = parameter(t.beta), t.gamma = parameter(t.gamma))
+				.on_conflict(t.beta).do_update(t.delta = parameter(t.delta)));
+		p.params.beta = "a";
+		p.params.gamma = true;
+		p.params.delta = 1;
+		p._bind_params();
+		ok &= test::check<std::string>("prepared", "0:a 1:1 2:1 ", p._prepared_statement._log);
+
+		decltype(p)::_batch_t rows(2);
+		rows[0].beta = "a";
+		rows[0].gamma = true;
+		rows[0].delta = 1;
+		rows[1].beta = "b";
+		rows[1].gamma = false;
+		rows[1].delta = 2;
+		db.run_batch(p, rows);
+		ok &= test::check<std::string>("batch", "0:a,b 1:1,0 2:1,2 ", p._prepared_statement._log);
+	}
+
+	// Chunked multi-row upsert
+	{
+		auto multi_insert = insert_into(t).columns(t.beta, t.gamma).on_conflict(t.beta).do_update(t.gamma = sqlpp::excluded(t.gamma));
+		multi_insert.values._data._placeholder_rows = 2;
+		ok &= test::check<std::string>("placeholders", "INSERT  INTO tab_bar (beta,gamma) VALUES (?,?),(?,?) ON CONFLICT (beta) DO UPDATE SET gamma=excluded.gamma",
+				to_sql(multi_insert));
+
+		multi_insert.values._data._placeholder_rows = 0;
+		for (int i = 0; i < 9; ++i)
+			multi_insert.values.add(t.beta = "row" + std::to_string(i), t.gamma = (i % 2 == 0));
+		auto inserter = sqlpp::chunked_insert(db, multi_insert);
+		ok &= test::check<std::size_t>("chunked rows", 9, inserter.run(multi_insert));
+	}
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,183 @@
+/*
+ * WriteCoalescerTest.cpp
+ *
+ * Copyright (c) 2015 Mapscape B.V.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Sample.h"
+#include "MockDb.h"
+#include "Check.h"
+#include <sqlpp11/sqlpp11.h>
+#include <sqlpp11/write_coalescer.h>
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace
+{
+	// Fails the given run of a statement, counting from 1
+	struct FailingDb: public MockDb
+	{
+		std::size_t _runs = 0;
+		std::size_t _failing_run = 0;
+
+		template<typename T>
+			std::size_t operator()(const T& t)
+			{
+				if (++_runs == _failing_run)
+					throw std::runtime_error("constraint violated");
+				return MockDb::operator()(t);
+			}
+	};
+
+	// The first commit fails like one running into a lock timeout, leaving the transaction open
+	struct FailingCommitDb: public MockDb
+	{
+		bool _failed = false;
+
+		void commit_transaction()
+		{
+			if (_failed)
+				return MockDb::commit_transaction();
+			_failed = true;
+			_transaction_log += "commit;";
+			throw sqlpp::exception("lock wait timeout exceeded");
+		}
+	};
+}
+
+int main()
+{
+	test::TabBar t;
+	bool ok = true;
+
+	sqlpp::write_coalescer_options_t options;
+	options.max_statements = 3;
+	options.max_delay = std::chrono::seconds(10);
+
+	// A full batch is committed at once, futures are resolved after the commit
+	{
+		MockDb db;
+		sqlpp::write_coalescer_t<MockDb> writer(db, options);
+		auto first = writer.submit(insert_into(t).set(t.beta = "a", t.gamma = true));
+		auto second = writer.submit(update(t).set(t.delta = 1).where(t.beta == "a"));
+		auto third = writer.submit(remove_from(t).where(t.beta == "a"));
+		third.get();
+		ok &= test::check<bool>("batched", true, first.wait_for(std::chrono::seconds(0)) == std::future_status::ready
+				and second.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+		ok &= test::check<std::string>("one commit", "begin;commit;", db._transaction_log);
+	}
+
+	// The byte threshold and flush() commit before the delay is over
+	{
+		MockDb db;
+		auto bytes = options;
+		bytes.max_bytes = 10;
+		sqlpp::write_coalescer_t<MockDb> writer(db, bytes);
+		auto written = writer.submit(remove_from(t).where(t.beta == "a"));
+		ok &= test::check<bool>("byte threshold", true, written.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+
+		auto flushed = writer.submit(remove_from(t).where(true));
+		writer.flush();
+		ok &= test::check<bool>("flushed", true, flushed.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+	}
+
+	// Flushing an empty queue does not affect later statements
+	{
+		MockDb db;
+		auto pair = options;
+		pair.max_statements = 2;
+		sqlpp::write_coalescer_t<MockDb> writer(db, pair);
+		writer.flush();
+		auto first = writer.submit(remove_from(t).where(t.beta == "a"));
+		// Gives a stale flush request time to commit the first statement alone
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		auto second = writer.submit(remove_from(t).where(t.beta == "b"));
+		first.get();
+		second.get();
+		ok &= test::check<std::string>("empty flush", "begin;commit;", db._transaction_log);
+	}
+
+	// A failing statement fails alone, the rest of its batch is committed without it
+	{
+		FailingDb db;
+		db._failing_run = 2;
+		sqlpp::write_coalescer_t<FailingDb> writer(db, options);
+		auto first = writer.submit(remove_from(t).where(t.beta == "a"));
+		auto second = writer.submit(remove_from(t).where(t.beta == "b"));
+		auto third = writer.submit(remove_from(t).where(t.beta == "c"));
+		try
+		{
+			second.get();
+			std::cerr << "failing statement: expected exception" << std::endl;
+			ok = false;
+		}
+		catch (const std::runtime_error&)
+		{
+		}
+		first.get();
+		third.get();
+		ok &= test::check<std::string>("retried", "begin;rollback;begin;commit;", db._transaction_log);
+	}
+
+	// A failed commit fails its batch and is rolled back, later batches are not affected
+	{
+		FailingCommitDb db;
+		sqlpp::write_coalescer_t<FailingCommitDb> writer(db, options);
+		auto first = writer.submit(remove_from(t).where(t.beta == "a"));
+		writer.flush();
+		try
+		{
+			first.get();
+			std::cerr << "failed commit: expected exception" << std::endl;
+			ok = false;
+		}
+		catch (const sqlpp::exception&)
+		{
+		}
+		auto second = writer.submit(remove_from(t).where(t.beta == "b"));
+		writer.flush();
+		second.get();
+		ok &= test::check<std::string>("failed commit", "begin;commit;rollback;begin;commit;", db._transaction_log);
+	}
+
+	// Statements still queued are committed on destruction
+	{
+		MockDb db;
+		std::future<std::size_t> pending;
+		{
+			sqlpp::write_coalescer_t<MockDb> writer(db, options);
+			pending = writer.submit(remove_from(t).where(true));
+		}
+		ok &= test::check<bool>("drained", true, pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+		ok &= test::check<std::string>("drained commit", "begin;commit;", db._transaction_log);
+	}
+
+	return ok ? 0 : -1;
+}